@@ -4,8 +4,8 @@
 #include "BTService_SetMoveState.h"
 
 #include "AIController.h"
-#include "GameFramework/Character.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "AIAssessment/Character/IsekaiCharacterBase.h"
+#include "AIAssessment/Character/IsekaiCharacterMovementComponent.h"
 
 UBTService_SetMoveState::UBTService_SetMoveState()
 { 
@@ -16,6 +16,14 @@ UBTService_SetMoveState::UBTService_SetMoveState()
 	bNotifyTick = false; 
 }
 
+void UBTService_SetMoveState::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryInit::Type InitType) const
+{
+	Super::InitializeMemory(OwnerComp, NodeMemory, InitType);
+	
+	CastInstanceNodeMemory<FMemoryData>(NodeMemory)->ProfileHandle = INDEX_NONE;
+}
+
 void UBTService_SetMoveState::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
 	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
@@ -23,36 +31,22 @@ void UBTService_SetMoveState::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp
 	const AAIController* AICon = OwnerComp.GetAIOwner();
 	if (!AICon) return;
 
-	ACharacter* Char = Cast<ACharacter>(AICon->GetPawn());
+	const AIsekaiCharacterBase* Char = Cast<AIsekaiCharacterBase>(AICon->GetPawn());
 	if (!Char) return;
 
 	FMemoryData* MyMemory = CastInstanceNodeMemory<FMemoryData>(NodeMemory);
 	
-	if (UCharacterMovementComponent* CMC = Char->GetCharacterMovement())
+	if (UIsekaiCharacterMovementComponent* CMC = Char->GetIsekaiCharacterMovement())
 	{
-		// 1. Snapshot Current State
-		MyMemory->PreviousSpeed = CMC->MaxWalkSpeed;
-		MyMemory->bWasOrientingToMovement = CMC->bOrientRotationToMovement;
-		MyMemory->bWasUsingDesiredRotation = CMC->bUseControllerDesiredRotation;
-
-		// 2. Apply Speed
-		CMC->MaxWalkSpeed = TargetSpeed;
+		FIsekaiMovementProfile Profile;
+		Profile.Priority = Priority;
+		Profile.MaxWalkSpeedOverride = TargetSpeed;
 		
-		// 3. Apply Rotation Mode
-		if (bUseStrafing)
-		{
-			// Strafing Mode:
-			// - Don't rotate towards velocity vector
-			CMC->bOrientRotationToMovement = false;
-			CMC->bUseControllerDesiredRotation = true;
-		}
-		else
-		{
-			// Free Roam Mode:
-			// - Face the direction of travel
-			CMC->bOrientRotationToMovement = true;
-			CMC->bUseControllerDesiredRotation = false;
-		}
+		// Strafing: don't rotate towards velocity, follow the focus instead
+		// Free Roam: face the direction of travel
+		Profile.RotationMode = bUseStrafing ? EIsekaiRotationMode::ControllerDesired : EIsekaiRotationMode::OrientToMovement;
+		
+		MyMemory->ProfileHandle = CMC->PushMovementProfile(Profile);
 	}
 }
 
@@ -60,19 +54,20 @@ void UBTService_SetMoveState::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp,
 {
 	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
 
+	FMemoryData* MyMemory = CastInstanceNodeMemory<FMemoryData>(NodeMemory);
+	const int32 ProfileHandle = MyMemory->ProfileHandle;
+	MyMemory->ProfileHandle = INDEX_NONE;
+	
+	if (ProfileHandle == INDEX_NONE) return;
+
 	const AAIController* AICon = OwnerComp.GetAIOwner();
 	if (!AICon) return;
 
-	const ACharacter* Char = Cast<ACharacter>(AICon->GetPawn());
+	const AIsekaiCharacterBase* Char = Cast<AIsekaiCharacterBase>(AICon->GetPawn());
 	if (!Char) return;
 
-	const FMemoryData* MyMemory = CastInstanceNodeMemory<FMemoryData>(NodeMemory);
-
-	// Restore State
-	if (UCharacterMovementComponent* CMC = Char->GetCharacterMovement())
+	if (UIsekaiCharacterMovementComponent* CMC = Char->GetIsekaiCharacterMovement())
 	{
-		CMC->MaxWalkSpeed = MyMemory->PreviousSpeed;
-		CMC->bOrientRotationToMovement = MyMemory->bWasOrientingToMovement;
-		CMC->bUseControllerDesiredRotation = MyMemory->bWasUsingDesiredRotation;
+		CMC->PopMovementProfile(ProfileHandle);
 	}
 }
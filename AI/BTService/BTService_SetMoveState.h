@@ -8,8 +8,8 @@
 
 
 /**
- * Configures Character Movement properties (Speed, Rotation Mode) for a specific state.
- * Restores them when exiting the state.
+ * Pushes a movement profile (Speed, Rotation Mode) onto the character's movement arbiter for a specific state.
+ * Pops it when exiting the state, so nested services never overwrite each other.
  */
 UCLASS()
 class AIASSESSMENT_API UBTService_SetMoveState : public UBTService
@@ -22,6 +22,7 @@ public:
 protected:
 	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
 
 	// --- Configuration ---
 	
@@ -30,13 +31,14 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ToolTip="If true, disables OrientToMovement and enables DesiredRotation (Strafing)."))
 	bool bUseStrafing = false;
+	
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ToolTip="Higher priority profiles win when several services are active at once."))
+	int32 Priority = 0;
 
 	// --- Internal State ---
 	struct FMemoryData
 	{
-		float PreviousSpeed;
-		bool bWasOrientingToMovement;
-		bool bWasUsingDesiredRotation;
+		int32 ProfileHandle;
 	};
 	
 	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FMemoryData); }
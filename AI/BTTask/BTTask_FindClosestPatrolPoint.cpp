@@ -4,6 +4,7 @@
 #include "BTTask_FindClosestPatrolPoint.h"
 
 #include "NavigationSystem.h"
+#include "AIAssessment/IsekaiStats.h"
 #include "AIAssessment/Actor/IsekaiPatrolPath.h"
 #include "AIAssessment/AI/IsekaiAIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -18,6 +19,8 @@ UBTTask_FindClosestPatrolPoint::UBTTask_FindClosestPatrolPoint()
 
 EBTNodeResult::Type UBTTask_FindClosestPatrolPoint::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_PatrolTask);
+	
 	AIsekaiAIController* AICon = Cast<AIsekaiAIController>(OwnerComp.GetAIOwner());
 	UBlackboardComponent* BB = OwnerComp.GetBlackboardComponent();
 	if (!AICon || !BB) return EBTNodeResult::Failed;
@@ -32,18 +35,28 @@ EBTNodeResult::Type UBTTask_FindClosestPatrolPoint::ExecuteTask(UBehaviorTreeCom
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
 
 	// 1. Find Closest Input Key (Float representation of location on spline, e.g., 2.5)
-	float ClosestInputKey = Spline->FindInputKeyClosestToWorldLocation(MyLoc);
+	float ClosestInputKey = PathActor->FindInputKeyClosestToWorldLocation(MyLoc);
 	FVector SplineLoc = Spline->GetLocationAtSplineInputKey(ClosestInputKey, ESplineCoordinateSpace::World);
 
-	// 2. Project to NavMesh
-	FNavLocation ProjectedLoc;
-	bool bOnNavMesh = false;
-	if (NavSys)
+	// 2. Project to NavMesh, merging right onto a waypoint can reuse the patrol path bake
+	FVector MoveToLoc = SplineLoc;
+	const int32 NearestPointIndex = FMath::RoundToInt(ClosestInputKey);
+	const FIsekaiBakedPatrolPoint* BakedPoint = FMath::IsNearlyEqual(ClosestInputKey, static_cast<float>(NearestPointIndex), 0.01f)
+		? PathActor->GetBakedPoint(NearestPointIndex)
+		: nullptr;
+	
+	if (BakedPoint)
 	{
-		bOnNavMesh = NavSys->ProjectPointToNavigation(SplineLoc, ProjectedLoc, FVector(200.f, 200.f, 500.f));
+		MoveToLoc = BakedPoint->NavLocation;
+	}
+	else if (NavSys)
+	{
+		FNavLocation ProjectedLoc;
+		if (NavSys->ProjectPointToNavigation(SplineLoc, ProjectedLoc, AIsekaiPatrolPath::GetNavProjectionExtent()))
+		{
+			MoveToLoc = ProjectedLoc.Location;
+		}
 	}
-	
-	FVector MoveToLoc = bOnNavMesh ? ProjectedLoc.Location : SplineLoc;
 
 	// 3. Determine the Patrol Index
 	// If we are at 2.5, we are "past" 2. So we set Index to 2.
@@ -6,27 +6,43 @@
 #include "AIController.h"
 #include "NavigationSystem.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
 #include "AIAssessment/Actor/IsekaiPatrolPath.h"
 #include "AIAssessment/AI/IsekaiAIController.h"
+#include "AIAssessment/Subsystem/World/AIPatrolSubsystem.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
 UBTTask_GetNextPatrolPoint::UBTTask_GetNextPatrolPoint()
 {
 	NodeName = TEXT("Get Next Patrol Point");
 	
+	// Only does work while waiting for a free path query slot
+	bNotifyTick = true;
+	
 	PatrolIndexKey.AddIntFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_GetNextPatrolPoint, PatrolIndexKey));
 	MoveToLocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_GetNextPatrolPoint, MoveToLocationKey));
 	PatrolDirectionKey.AddIntFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_GetNextPatrolPoint, PatrolDirectionKey));
 }
 
+uint16 UBTTask_GetNextPatrolPoint::GetInstanceMemorySize() const
+{
+	return sizeof(FPatrolQueryMemory);
+}
+
 EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_PatrolTask);
+	
+	FPatrolQueryMemory* Memory = CastInstanceNodeMemory<FPatrolQueryMemory>(NodeMemory);
+	Memory->QueryID = INVALID_NAVQUERYID;
+	Memory->bWaitingForSlot = false;
+	
 	UBlackboardComponent* BB = OwnerComp.GetBlackboardComponent();
 	if (!BB) return EBTNodeResult::Failed;
 	
 	
 	// Get Patrol Path
-	AIsekaiAIController* AICon = Cast<AIsekaiAIController>(OwnerComp.GetAIOwner());
+	const AIsekaiAIController* AICon = Cast<AIsekaiAIController>(OwnerComp.GetAIOwner());
 	if (!IsValid(AICon)) return EBTNodeResult::Failed;
 	
 	const AIsekaiPatrolPath* PatrolPath = AICon->GetPatrolPath();
@@ -37,14 +53,71 @@ EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteTask(UBehaviorTreeCompone
 	const int32 NumPoints = PatrolPath->GetNumberOfSplinePoints();
 	if (NumPoints == 0) return EBTNodeResult::Failed;
 	
-	const int32 CurrentIndex = BB->GetValueAsInt(PatrolIndexKey.SelectedKeyName);
+	const int32 FromIndex = BB->GetValueAsInt(PatrolIndexKey.SelectedKeyName);
+	const int32 NextIndex = CalculateNextIndex(*BB, *PatrolPath);
+	
+	if (!bCheckReachability || !bAsyncReachability)
+	{
+		return ExecuteSync(OwnerComp, *PatrolPath, FromIndex, NextIndex);
+	}
+	
+	Memory->CandidateLocation = FVector::ZeroVector;
+	Memory->CandidateIndex = NextIndex;
+	Memory->FromIndex = FromIndex;
+	Memory->NumPoints = NumPoints;
+	Memory->Attempt = 0;
+	
+	return ContinueAsyncSearch(OwnerComp, *Memory);
+}
+
+EBTNodeResult::Type UBTTask_GetNextPatrolPoint::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FPatrolQueryMemory* Memory = CastInstanceNodeMemory<FPatrolQueryMemory>(NodeMemory);
+	
+	if (Memory->QueryID != INVALID_NAVQUERYID)
+	{
+		if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(OwnerComp.GetWorld()))
+		{
+			NavSys->AbortAsyncFindPathRequest(Memory->QueryID);
+		}
+		if (UAIPatrolSubsystem* PatrolSubsystem = UWorld::GetSubsystem<UAIPatrolSubsystem>(OwnerComp.GetWorld()))
+		{
+			PatrolSubsystem->ReleasePathQuery(Memory->QueryID);
+		}
+		
+		// Any result still in flight is ignored once the ID no longer matches
+		Memory->QueryID = INVALID_NAVQUERYID;
+	}
+	Memory->bWaitingForSlot = false;
+	
+	return EBTNodeResult::Aborted;
+}
+
+void UBTTask_GetNextPatrolPoint::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_PatrolTask);
+	
+	FPatrolQueryMemory* Memory = CastInstanceNodeMemory<FPatrolQueryMemory>(NodeMemory);
+	if (!Memory->bWaitingForSlot) return;
 	
-	int32 Direction = BB->GetValueAsInt(PatrolDirectionKey.SelectedKeyName);
+	const EBTNodeResult::Type Result = ContinueAsyncSearch(OwnerComp, *Memory);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(OwnerComp, Result);
+	}
+}
+
+int32 UBTTask_GetNextPatrolPoint::CalculateNextIndex(UBlackboardComponent& BB, const AIsekaiPatrolPath& PatrolPath) const
+{
+	const int32 NumPoints = PatrolPath.GetNumberOfSplinePoints();
+	const int32 CurrentIndex = BB.GetValueAsInt(PatrolIndexKey.SelectedKeyName);
+	
+	int32 Direction = BB.GetValueAsInt(PatrolDirectionKey.SelectedKeyName);
 	if (Direction == 0) Direction = 1; // Default to forward
 	
 	int32 NextIndex = -1;
 	
-	if (PatrolPath->IsLooping())
+	if (PatrolPath.IsLooping())
 	{
 		// Standard Loop: 0 -> 1 -> 2 -> ... -> N -> 0
 		NextIndex = (CurrentIndex + Direction) % NumPoints;
@@ -67,11 +140,54 @@ EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteTask(UBehaviorTreeCompone
 		}
 		
 		// Update direction in Blackboard
-		BB->SetValueAsInt(PatrolDirectionKey.SelectedKeyName, Direction);
+		BB.SetValueAsInt(PatrolDirectionKey.SelectedKeyName, Direction);
 	}
 	
-	NextIndex = FMath::Clamp(NextIndex, 0, FMath::Max(0, NumPoints - 1));
+	return FMath::Clamp(NextIndex, 0, FMath::Max(0, NumPoints - 1));
+}
+
+bool UBTTask_GetNextPatrolPoint::ProjectCandidate(const UNavigationSystemV1* NavSys, const AIsekaiPatrolPath& PatrolPath, const int32 Index, FVector& OutLocation) const
+{
+	// Baked projection is free, only fall back to a live projection without a valid bake
+	if (const FIsekaiBakedPatrolPoint* Baked = PatrolPath.GetBakedPoint(Index))
+	{
+		OutLocation = Baked->NavLocation;
+		return Baked->bOnNavmesh;
+	}
+	
+	const FVector SplineWorldLoc = PatrolPath.GetSplinePointLocation(Index);
+	FNavLocation ProjectedLoc;
+	
+	// Project to NavMesh
+	bool bOnNavmesh = false;
+	if (NavSys)
+	{
+		bOnNavmesh = NavSys->ProjectPointToNavigation(SplineWorldLoc, ProjectedLoc, AIsekaiPatrolPath::GetNavProjectionExtent());
+	}
 	
+	OutLocation = bOnNavmesh ? ProjectedLoc.Location : SplineWorldLoc;
+	return bOnNavmesh;
+}
+
+bool UBTTask_GetNextPatrolPoint::GetBakedReachability(const AIsekaiPatrolPath& PatrolPath, const int32 FromIndex, const int32 ToIndex, bool& bOutReachable)
+{
+	// The bake stores waypoint-to-waypoint reachability, which only applies while the AI is leaving FromIndex
+	return PatrolPath.GetBakedSegmentReachability(FromIndex, ToIndex, bOutReachable);
+}
+
+void UBTTask_GetNextPatrolPoint::CommitResult(UBehaviorTreeComponent& OwnerComp, const FVector& Location, const int32 Index) const
+{
+	if (UBlackboardComponent* BB = OwnerComp.GetBlackboardComponent())
+	{
+		BB->SetValueAsVector(MoveToLocationKey.SelectedKeyName, Location);
+		BB->SetValueAsInt(PatrolIndexKey.SelectedKeyName, Index);
+	}
+}
+
+EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteSync(UBehaviorTreeComponent& OwnerComp, const AIsekaiPatrolPath& PatrolPath, const int32 FromIndex, int32 NextIndex) const
+{
+	const AAIController* AICon = OwnerComp.GetAIOwner();
+	const int32 NumPoints = PatrolPath.GetNumberOfSplinePoints();
 	
 	// Resolve Location
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
@@ -81,23 +197,13 @@ EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteTask(UBehaviorTreeCompone
 	
 	
 	// Retry loop: If point N is blocked, try N+1 (Max 2 attempts to avoid infinite loops/freeze)
-	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
 	{
-		FVector SplineWorldLoc = PatrolPath->GetSplinePointLocation(NextIndex);
-		FNavLocation ProjectedLoc;
-		
-		// Project to NavMesh
-		bool bOnNavmesh = false;
-		if (NavSys)
-		{
-			bOnNavmesh = NavSys->ProjectPointToNavigation(SplineWorldLoc, ProjectedLoc, FVector(200.f, 200.f, 500.f));
-		}
-		
-		TargetLocation = bOnNavmesh ? ProjectedLoc.Location : SplineWorldLoc;
+		const bool bOnNavmesh = ProjectCandidate(NavSys, PatrolPath, NextIndex, TargetLocation);
 		
 		// Check Reachability
 		bool bReachable = true;
-		if (bCheckReachability && AICon && bOnNavmesh)
+		if (bCheckReachability && AICon && AICon->GetPawn() && bOnNavmesh && !GetBakedReachability(PatrolPath, FromIndex, NextIndex, bReachable))
 		{
 			FPathFindingQuery Query;
 			Query.StartLocation = AICon->GetPawn()->GetActorLocation();
@@ -122,13 +228,144 @@ EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ExecuteTask(UBehaviorTreeCompone
 	
 	if (!bFoundValidPoint)
 	{
-		UE_LOG(LogIsekaiAI, Error, TEXT("No valid patrol points found on path %s."), *PatrolPath->GetName());
+		UE_LOG(LogIsekaiAI, Error, TEXT("No valid patrol points found on path %s."), *PatrolPath.GetName());
 		return EBTNodeResult::Failed;
 	}
 	
 	// Commit to Blackboard
-	BB->SetValueAsVector(MoveToLocationKey.SelectedKeyName, TargetLocation);
-	BB->SetValueAsInt(PatrolIndexKey.SelectedKeyName, NextIndex);
+	CommitResult(OwnerComp, TargetLocation, NextIndex);
 	
 	return EBTNodeResult::Succeeded;
 }
+
+EBTNodeResult::Type UBTTask_GetNextPatrolPoint::ContinueAsyncSearch(UBehaviorTreeComponent& OwnerComp, FPatrolQueryMemory& Memory)
+{
+	const AIsekaiAIController* AICon = Cast<AIsekaiAIController>(OwnerComp.GetAIOwner());
+	const AIsekaiPatrolPath* PatrolPath = AICon ? AICon->GetPatrolPath() : nullptr;
+	if (!IsValid(PatrolPath) || !AICon->GetPawn())
+	{
+		Memory.bWaitingForSlot = false;
+		return EBTNodeResult::Failed;
+	}
+	
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(OwnerComp.GetWorld());
+	
+	// Same retry rules as the sync path, the only difference is that reachability completes in OnPathQueryFinished
+	while (Memory.Attempt < MaxAttempts)
+	{
+		bool bCandidateValid = Memory.bWaitingForSlot;
+		if (!bCandidateValid)
+		{
+			bCandidateValid = ProjectCandidate(NavSys, *PatrolPath, Memory.CandidateIndex, Memory.CandidateLocation);
+		}
+		
+		// A baked answer completes the search without touching the navigation system
+		bool bBakedReachable = false;
+		if (bCandidateValid && GetBakedReachability(*PatrolPath, Memory.FromIndex, Memory.CandidateIndex, bBakedReachable))
+		{
+			if (bBakedReachable)
+			{
+				Memory.bWaitingForSlot = false;
+				CommitResult(OwnerComp, Memory.CandidateLocation, Memory.CandidateIndex);
+				return EBTNodeResult::Succeeded;
+			}
+			bCandidateValid = false;
+		}
+		
+		if (bCandidateValid)
+		{
+			UAIPatrolSubsystem* PatrolSubsystem = UWorld::GetSubsystem<UAIPatrolSubsystem>(OwnerComp.GetWorld());
+			if (PatrolSubsystem && !PatrolSubsystem->TryAcquirePathQuerySlot())
+			{
+				// Over budget, TickTask tries again next frame
+				Memory.bWaitingForSlot = true;
+				return EBTNodeResult::InProgress;
+			}
+			Memory.bWaitingForSlot = false;
+			
+			if (IssuePathQuery(OwnerComp, Memory))
+			{
+				return EBTNodeResult::InProgress;
+			}
+			
+			if (PatrolSubsystem)
+			{
+				PatrolSubsystem->ReleasePathQuerySlot();
+			}
+		}
+		
+		UE_LOG(LogIsekaiAI, Warning, TEXT("Patrol Point %d is unreachable or off-mesh. Skipping."), Memory.CandidateIndex);
+		Memory.CandidateIndex = (Memory.CandidateIndex + 1) % Memory.NumPoints; // Try next
+		++Memory.Attempt;
+	}
+	
+	UE_LOG(LogIsekaiAI, Error, TEXT("No valid patrol points found on path %s."), *PatrolPath->GetName());
+	return EBTNodeResult::Failed;
+}
+
+bool UBTTask_GetNextPatrolPoint::IssuePathQuery(UBehaviorTreeComponent& OwnerComp, FPatrolQueryMemory& Memory)
+{
+	const AAIController* AICon = OwnerComp.GetAIOwner();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(OwnerComp.GetWorld());
+	if (!NavSys || !AICon || !AICon->GetPawn()) return false;
+	
+	FPathFindingQuery Query;
+	Query.StartLocation = AICon->GetPawn()->GetActorLocation();
+	Query.EndLocation = Memory.CandidateLocation;
+	Query.NavData = NavSys->GetDefaultNavDataInstance();
+	Query.SetNavAgentProperties(AICon->GetNavAgentPropertiesRef());
+	
+	UAIPatrolSubsystem* PatrolSubsystem = UWorld::GetSubsystem<UAIPatrolSubsystem>(OwnerComp.GetWorld());
+	
+	const uint32 QueryID = NavSys->FindPathAsync(AICon->GetNavAgentPropertiesRef(), Query,
+		FNavPathQueryDelegate::CreateUObject(this, &ThisClass::OnPathQueryFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp), TWeakObjectPtr<UAIPatrolSubsystem>(PatrolSubsystem)),
+		EPathFindingMode::Hierarchical);
+	
+	if (QueryID == INVALID_NAVQUERYID) return false;
+	
+	if (PatrolSubsystem)
+	{
+		PatrolSubsystem->TrackPathQuery(QueryID);
+	}
+	
+	Memory.QueryID = QueryID;
+	return true;
+}
+
+void UBTTask_GetNextPatrolPoint::OnPathQueryFinished(const uint32 QueryID, const ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, TWeakObjectPtr<UAIPatrolSubsystem> WeakPatrolSubsystem)
+{
+	// Release first, a BT destroyed mid-query would otherwise leak the slot
+	if (UAIPatrolSubsystem* PatrolSubsystem = WeakPatrolSubsystem.Get())
+	{
+		PatrolSubsystem->ReleasePathQuery(QueryID);
+	}
+	
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	if (!OwnerComp) return;
+	
+	// Ignore results for queries that were aborted or belong to an earlier execution
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (!NodeMemory) return;
+	
+	FPatrolQueryMemory* Memory = CastInstanceNodeMemory<FPatrolQueryMemory>(NodeMemory);
+	if (Memory->QueryID != QueryID) return;
+	
+	Memory->QueryID = INVALID_NAVQUERYID;
+	
+	if (Result == ENavigationQueryResult::Success)
+	{
+		CommitResult(*OwnerComp, Memory->CandidateLocation, Memory->CandidateIndex);
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+	
+	UE_LOG(LogIsekaiAI, Warning, TEXT("Patrol Point %d is unreachable or off-mesh. Skipping."), Memory->CandidateIndex);
+	Memory->CandidateIndex = (Memory->CandidateIndex + 1) % Memory->NumPoints; // Try next
+	++Memory->Attempt;
+	
+	const EBTNodeResult::Type NextResult = ContinueAsyncSearch(*OwnerComp, *Memory);
+	if (NextResult != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(*OwnerComp, NextResult);
+	}
+}
@@ -3,12 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "NavigationData.h"
 #include "BehaviorTree/BTTaskNode.h"
 #include "BTTask_GetNextPatrolPoint.generated.h"
 
+class AIsekaiPatrolPath;
+class UNavigationSystemV1;
+class UAIPatrolSubsystem;
+
 /**
  * Calculates the next waypoint on the assigned Patrol Spline.
  * Includes NavMesh projection and reachability tests to prevent AI getting stuck.
+ * Reachability can be tested asynchronously, in which case the task stays latent until the path query returns.
  */
 UCLASS()
 class AIASSESSMENT_API UBTTask_GetNextPatrolPoint : public UBTTaskNode
@@ -18,6 +24,9 @@ public:
 	UBTTask_GetNextPatrolPoint();
 	
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual uint16 GetInstanceMemorySize() const override;
 	
 protected:
 	UPROPERTY(EditAnywhere, Category="Blackboard")
@@ -32,4 +41,40 @@ protected:
 	/** If true, verifies the path exists before committing. */
 	UPROPERTY(EditAnywhere, Category="Config")
 	bool bCheckReachability = true;
-};
\ No newline at end of file
+
+	/** If true, the reachability test runs as an async path query instead of blocking the game thread. */
+	UPROPERTY(EditAnywhere, Category="Config", meta=(EditCondition="bCheckReachability"))
+	bool bAsyncReachability = true;
+
+	// --- Internal Memory ---
+	struct FPatrolQueryMemory
+	{
+		FVector CandidateLocation;
+		uint32 QueryID;
+		int32 CandidateIndex;
+		/** Waypoint the AI is leaving, lets the patrol path bake answer reachability. */
+		int32 FromIndex;
+		int32 NumPoints;
+		int32 Attempt;
+		bool bWaitingForSlot;
+	};
+
+private:
+	/** Max candidates tested per execution. If point N is blocked, try N+1. */
+	static constexpr int32 MaxAttempts = 2;
+
+	int32 CalculateNextIndex(UBlackboardComponent& BB, const AIsekaiPatrolPath& PatrolPath) const;
+	bool ProjectCandidate(const UNavigationSystemV1* NavSys, const AIsekaiPatrolPath& PatrolPath, int32 Index, FVector& OutLocation) const;
+	/** @return false if the patrol path bake can't answer and a live path test is needed. */
+	static bool GetBakedReachability(const AIsekaiPatrolPath& PatrolPath, int32 FromIndex, int32 ToIndex, bool& bOutReachable);
+	void CommitResult(UBehaviorTreeComponent& OwnerComp, const FVector& Location, int32 Index) const;
+
+	EBTNodeResult::Type ExecuteSync(UBehaviorTreeComponent& OwnerComp, const AIsekaiPatrolPath& PatrolPath, int32 FromIndex, int32 NextIndex) const;
+
+	// --- Async ---
+	/** Tests candidates until a query is in flight, or the attempts run out. */
+	EBTNodeResult::Type ContinueAsyncSearch(UBehaviorTreeComponent& OwnerComp, FPatrolQueryMemory& Memory);
+	bool IssuePathQuery(UBehaviorTreeComponent& OwnerComp, FPatrolQueryMemory& Memory);
+	/** The patrol subsystem is bound at issue time, so the query slot is released even if the BT is gone by now. */
+	void OnPathQueryFinished(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, TWeakObjectPtr<UAIPatrolSubsystem> WeakPatrolSubsystem);
+};
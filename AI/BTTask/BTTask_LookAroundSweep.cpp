@@ -3,12 +3,13 @@
 
 #include "BTTask_LookAroundSweep.h"
 #include "AIController.h"
+#include "AIAssessment/IsekaiStats.h"
+#include "AIAssessment/Subsystem/World/AILookSweepSubsystem.h"
 #include "GameFramework/Pawn.h"
 
 UBTTask_LookAroundSweep::UBTTask_LookAroundSweep()
 {
 	NodeName = TEXT("Look Around Sweep");
-	bNotifyTick = true;
 	bNotifyTaskFinished = true;
 }
 
@@ -19,61 +20,45 @@ uint16 UBTTask_LookAroundSweep::GetInstanceMemorySize() const
 
 EBTNodeResult::Type UBTTask_LookAroundSweep::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_PatrolTask);
+	
+	FLookSweepMemory* Memory = CastInstanceNodeMemory<FLookSweepMemory>(NodeMemory);
+	Memory->SweepHandle = INDEX_NONE;
+
 	AAIController* AICon = OwnerComp.GetAIOwner();
 	if (!AICon) return EBTNodeResult::Failed;
 	
 	const APawn* Pawn = AICon->GetPawn();
 	if (!Pawn) return EBTNodeResult::Failed;
 
-	FLookSweepMemory* Memory = CastInstanceNodeMemory<FLookSweepMemory>(NodeMemory);
-	
-	// 1. Snapshot the "Forward" direction at start of task
-	Memory->BaseForward = Pawn->GetActorForwardVector();
-	Memory->CurrentTime = 0.f;
-	
-	// Apply Duration
-	Memory->MaxTime = TotalDuration;
+	UAILookSweepSubsystem* SweepSubsystem = UWorld::GetSubsystem<UAILookSweepSubsystem>(OwnerComp.GetWorld());
+	if (!SweepSubsystem) return EBTNodeResult::Failed;
 
-	return EBTNodeResult::InProgress;
+	// Snapshot the "Forward" direction at start of task, the subsystem drives the sweep from here
+	FAILookSweepParams Params;
+	Params.BaseForward = Pawn->GetActorForwardVector();
+	Params.HalfAngle = HalfAngle;
+	Params.LookDistance = LookDistance;
+	Params.SweepSpeed = SweepSpeed;
+	Params.Duration = TotalDuration;
+
+	Memory->SweepHandle = SweepSubsystem->RegisterSweep(AICon, Params, &OwnerComp, this);
+
+	return Memory->SweepHandle != INDEX_NONE ? EBTNodeResult::InProgress : EBTNodeResult::Failed;
 }
 
-void UBTTask_LookAroundSweep::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTTask_LookAroundSweep::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
 {
 	FLookSweepMemory* Memory = CastInstanceNodeMemory<FLookSweepMemory>(NodeMemory);
-	AAIController* AICon = OwnerComp.GetAIOwner();
-	
-	// Safety Checks
-	if (!AICon || !AICon->GetPawn())
+	if (Memory->SweepHandle != INDEX_NONE)
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
-		return;
+		if (UAILookSweepSubsystem* SweepSubsystem = UWorld::GetSubsystem<UAILookSweepSubsystem>(OwnerComp.GetWorld()))
+		{
+			SweepSubsystem->UnregisterSweep(Memory->SweepHandle);
+		}
+		Memory->SweepHandle = INDEX_NONE;
 	}
 
-	// 1. Update Time
-	Memory->CurrentTime += DeltaSeconds;
-
-	// 2. Check Finish Condition
-	if (TotalDuration > 0.f && Memory->CurrentTime >= Memory->MaxTime)
-	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-		return;
-	}
-
-	// 3. Calculate Sine Sweep
-	// Sine goes -1 to 1. Map to -Angle to +Angle.
-	const float SineVal = FMath::Sin(Memory->CurrentTime * SweepSpeed);
-	const float CurrentAngle = SineVal * HalfAngle;
-
-	// 4. Calculate Vector
-	const FVector RotatedDir = Memory->BaseForward.RotateAngleAxis(CurrentAngle, FVector::UpVector);
-	const FVector TargetPos = AICon->GetPawn()->GetActorLocation() + (RotatedDir * LookDistance);
-
-	// 5. DIRECTLY Update Focus
-	AICon->SetFocalPoint(TargetPos, EAIFocusPriority::Gameplay);
-}
-
-void UBTTask_LookAroundSweep::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
-{
 	// Clean up focus so we don't get stuck staring at the last calculated point
 	if (AAIController* AICon = OwnerComp.GetAIOwner())
 	{
@@ -88,4 +73,4 @@ FString UBTTask_LookAroundSweep::GetStaticDescription() const
 	return FString::Printf(TEXT("Directly sweeps Focal Point +/- %.0f deg\nDuration: %.1fs"), 
 		HalfAngle, 
 		TotalDuration);
-}
\ No newline at end of file
+}
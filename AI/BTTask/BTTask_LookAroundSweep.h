@@ -9,6 +9,7 @@
 /**
  * Sweeps the AI's focal point back and forth in a cone.
  * Directly updates the AIController's Focus, no Blackboard Key needed.
+ * The sweep itself is evaluated by UAILookSweepSubsystem, this task only registers and unregisters it.
  */
 UCLASS()
 class AIASSESSMENT_API UBTTask_LookAroundSweep : public UBTTaskNode
@@ -20,7 +21,6 @@ public:
 
 	// --- BT Interface ---
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
 	virtual uint16 GetInstanceMemorySize() const override;
 	virtual FString GetStaticDescription() const override;
@@ -41,10 +41,6 @@ public:
 	// --- Internal Memory ---
 	struct FLookSweepMemory
 	{
-		FVector BaseForward;
-		float CurrentTime;
-		float MaxTime;
-		// Store previous focus to optionally restore it? 
-		// Usually for a task like this, clearing focus on exit is safer.
+		int32 SweepHandle;
 	};
 };
\ No newline at end of file
@@ -3,13 +3,21 @@
 
 #include "IsekaiAIController.h"
 
+#include "IsekaiBehaviorTreeComponent.h"
 #include "IsekaiBlackboardKeys.h"
+#include "IsekaiPerceptionProfile.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
 #include "AIAssessment/Actor/IsekaiPatrolPath.h"
 #include "AIAssessment/Character/IsekaiAICharacter.h"
 #include "AIAssessment/Component/AIStealthComponent.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "AIAssessment/Subsystem/World/AIPatrolSubsystem.h"
+#include "AIAssessment/Subsystem/World/AIPerceptionBudgetSubsystem.h"
+#include "AIAssessment/Subsystem/World/AISignificanceSubsystem.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Hearing.h"
 #include "Perception/AISenseConfig_Sight.h"
@@ -17,6 +25,9 @@
 
 AIsekaiAIController::AIsekaiAIController()
 {
+	// RunBehaviorTree reuses an existing tree component, this one can be throttled per significance tier
+	BrainComponent = CreateDefaultSubobject<UIsekaiBehaviorTreeComponent>(TEXT("BTComponent"));
+	
 	SetupPerceptionSystem();
 }
 
@@ -71,9 +82,30 @@ void AIsekaiAIController::OnPossess(APawn* InPawn)
 	
 	if (ControlledAICharacter.IsValid())
 	{
+		const UIsekaiPerceptionProfile* Profile = ControlledAICharacter->GetPerceptionProfile();
+		if (!Profile)
+		{
+			Profile = GetDefault<UIsekaiPerceptionProfile>();
+		}
+		ApplyPerceptionProfile(Profile);
+		
+		if (UAIPerceptionBudgetSubsystem* PerceptionBudget = GetWorld()->GetSubsystem<UAIPerceptionBudgetSubsystem>())
+		{
+			PerceptionBudget->RegisterListener(this, Profile->StimulusProcessInterval);
+		}
+		
+		// A recycled controller comes back with perception shut down by HandlePawnDeath
+		SetPerceptionEnabled(true);
+		
 		InitAIBehavior();
 		
 		SetGenericTeamId(ControlledAICharacter->GetGenericTeamId());
+		
+		// Applies the initial tier right away
+		if (UAISignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UAISignificanceSubsystem>())
+		{
+			SignificanceSubsystem->RegisterAI(this);
+		}
 	}
 	else
 	{
@@ -83,13 +115,33 @@ void AIsekaiAIController::OnPossess(APawn* InPawn)
 
 void AIsekaiAIController::OnUnPossess()
 {
+	if (UAISignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UAISignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterAI(this);
+	}
+	if (UAIPerceptionBudgetSubsystem* PerceptionBudget = GetWorld()->GetSubsystem<UAIPerceptionBudgetSubsystem>())
+	{
+		PerceptionBudget->UnregisterListener(this);
+	}
+	
+	CancelPatrolPathLoad();
 	ControlledAICharacter.Reset();
 	
 	Super::OnUnPossess();
 }
 
-void AIsekaiAIController::HandlePawnDeath()
+void AIsekaiAIController::HandlePawnDeath(const bool bDestroyController)
 {
+	// Dead AI must not be woken up again by a tier change or a late perception update
+	if (UAISignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UAISignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterAI(this);
+	}
+	if (UAIPerceptionBudgetSubsystem* PerceptionBudget = GetWorld()->GetSubsystem<UAIPerceptionBudgetSubsystem>())
+	{
+		PerceptionBudget->UnregisterListener(this);
+	}
+	
 	// Stop the brain
 	if (UBehaviorTreeComponent* BTComp = Cast<UBehaviorTreeComponent>(BrainComponent))
 	{
@@ -99,18 +151,126 @@ void AIsekaiAIController::HandlePawnDeath()
 	StopMovement();
 
 	// Stop perception
-	if (IsValid(PerceptionComponent))
+	SetPerceptionEnabled(false);
+	
+	ClearFocus(EAIFocusPriority::Gameplay);
+	
+	CancelPatrolPathLoad();
+	
+	ResetBlackboard();
+	
+	if (bDestroyController)
+	{
+		Destroy();
+	}
+}
+
+void AIsekaiAIController::SetPerceptionEnabled(const bool bEnabled)
+{
+	SetSensesEnabled(bEnabled, bEnabled);
+}
+
+void AIsekaiAIController::SetSensesEnabled(bool bSightEnabled, bool bHearingEnabled)
+{
+	if (!IsValid(PerceptionComponent))
+	{
+		return;
+	}
+	
+	bSightEnabled &= bProfileSightEnabled;
+	bHearingEnabled &= bProfileHearingEnabled;
+	
+	PerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), bSightEnabled);
+	PerceptionComponent->SetSenseEnabled(UAISense_Hearing::StaticClass(), bHearingEnabled);
+	
+	if (!bSightEnabled && !bHearingEnabled)
 	{
-		PerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
-		PerceptionComponent->SetSenseEnabled(UAISense_Hearing::StaticClass(), false);
 		PerceptionComponent->OnTargetPerceptionUpdated.RemoveAll(this);
 	}
+	else if (HasAuthority())
+	{
+		PerceptionComponent->OnTargetPerceptionUpdated.AddUniqueDynamic(this, &ThisClass::OnTargetPerceptionUpdated);
+	}
+}
+
+void AIsekaiAIController::ApplyPerceptionProfile(const UIsekaiPerceptionProfile* Profile)
+{
+	if (!Profile || !IsValid(PerceptionComponent)) return;
 	
-	ClearFocus(EAIFocusPriority::Gameplay);
+	bProfileSightEnabled = Profile->bEnableSight;
+	bProfileHearingEnabled = Profile->bEnableHearing;
 	
-	ResetBlackboard();
+	if (UAISenseConfig_Sight* Sight = Cast<UAISenseConfig_Sight>(PerceptionComponent->GetSenseConfig(UAISense::GetSenseID<UAISense_Sight>())))
+	{
+		Sight->SightRadius = Profile->SightRadius;
+		Sight->LoseSightRadius = FMath::Max(Profile->LoseSightRadius, Profile->SightRadius);
+		Sight->PeripheralVisionAngleDegrees = Profile->PeripheralVisionAngleDegrees;
+		Sight->PointOfViewBackwardOffset = Profile->PointOfViewBackwardOffset;
+		Sight->NearClippingRadius = Profile->NearClippingRadius;
+		Sight->SetMaxAge(Profile->SightMaxAge);
+		
+		// The component copies max age out of the config when it is configured, re-register it to pick up the new one
+		PerceptionComponent->ConfigureSense(*Sight);
+	}
 	
-	Destroy();
+	if (UAISenseConfig_Hearing* Hearing = Cast<UAISenseConfig_Hearing>(PerceptionComponent->GetSenseConfig(UAISense::GetSenseID<UAISense_Hearing>())))
+	{
+		Hearing->HearingRange = Profile->HearingRange;
+		Hearing->SetMaxAge(Profile->HearingMaxAge);
+		PerceptionComponent->ConfigureSense(*Hearing);
+	}
+	
+	// Sight digests listener properties on update, so the new ranges only take effect after this
+	PerceptionComponent->RequestStimuliListenerUpdate();
+}
+
+void AIsekaiAIController::ApplySignificanceTier(const EIsekaiAISignificance Tier)
+{
+	AIsekaiAICharacter* AIChar = ControlledAICharacter.Get();
+	if (!AIChar || !HasAuthority()) return;
+	
+	const UIsekaiAISettings* Settings = GetDefault<UIsekaiAISettings>();
+	const bool bReducedTier = Tier >= EIsekaiAISignificance::Low;
+	
+	// 1. Brain, the tree accumulates the real delta so timers and waits stay correct
+	if (UIsekaiBehaviorTreeComponent* BTComp = Cast<UIsekaiBehaviorTreeComponent>(BrainComponent))
+	{
+		BTComp->SetMinTickInterval(Settings->GetBrainTickInterval(Tier));
+	}
+	
+	// 2. Perception, sight is the expensive sense (line traces), hearing is event driven
+	SetSensesEnabled(!bReducedTier, Tier != EIsekaiAISignificance::Dormant);
+	
+	// 3. Movement, NavWalking skips floor sweeps and collision, the mode replicates through the engine
+	if (UCharacterMovementComponent* MoveComp = AIChar->GetCharacterMovement())
+	{
+		MoveComp->SetComponentTickInterval(bReducedTier ? Settings->ReducedMovementTickInterval : 0.f);
+		MoveComp->SetGroundMovementMode(bReducedTier ? MOVE_NavWalking : MOVE_Walking);
+		
+		if (MoveComp->IsMovingOnGround())
+		{
+			MoveComp->SetMovementMode(bReducedTier ? MOVE_NavWalking : MOVE_Walking);
+		}
+	}
+	
+	// 4. Animation, only montages are needed for ability timing once nobody is close enough to see bones
+	if (USkeletalMeshComponent* Mesh = AIChar->GetMesh())
+	{
+		switch (Tier)
+		{
+		case EIsekaiAISignificance::High:
+			Mesh->VisibilityBasedAnimTickOption = AIChar->GetDefaultAnimTickOption();
+			break;
+		case EIsekaiAISignificance::Medium:
+			Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+			break;
+		default:
+			Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+			break;
+		}
+	}
+	
+	UE_LOG(LogIsekaiAI, Verbose, TEXT("AIsekaiAIController::ApplySignificanceTier: %s -> %s"), *GetNameSafe(AIChar), *UEnum::GetValueAsString(Tier));
 }
 
 void AIsekaiAIController::InitAIBehavior()
@@ -136,21 +296,7 @@ void AIsekaiAIController::InitAIBehavior()
 	ResetBlackboard();
 	
 	// Cache Patrol Path if assigned
-	if (ControlledAICharacter.IsValid())
-	{
-		if (ControlledAICharacter->GetPatrolPath().IsValid())
-		{
-			CachedPatrolPath = ControlledAICharacter->GetPatrolPath().Get();
-		}
-		else if (!ControlledAICharacter->GetPatrolPath().IsNull())
-		{
-			// Try to load it
-			if (AIsekaiPatrolPath* LoadedPath = ControlledAICharacter->GetPatrolPath().LoadSynchronous())
-			{
-				CachedPatrolPath = LoadedPath;
-			}
-		}
-	}
+	RequestPatrolPath();
 	
 	// Initialize Stealth Component on the Server
 	if (UAIStealthComponent* StealthComp = ControlledAICharacter.Get()->GetStealthComponent())
@@ -165,7 +311,95 @@ void AIsekaiAIController::InitAIBehavior()
 	}
 }
 
+void AIsekaiAIController::RequestPatrolPath()
+{
+	CancelPatrolPathLoad();
+	CachedPatrolPath.Reset();
+	
+	if (!ControlledAICharacter.IsValid()) return;
+	
+	const TSoftObjectPtr<AIsekaiPatrolPath> PatrolPath = ControlledAICharacter->GetPatrolPath();
+	if (PatrolPath.IsValid())
+	{
+		CachedPatrolPath = PatrolPath.Get();
+		return;
+	}
+	
+	if (PatrolPath.IsNull()) return;
+	
+	// Until the path is resident GetPatrolPath() returns null, so the tree keeps the AI idling in place
+	if (UAIPatrolSubsystem* PatrolSubsystem = GetWorld()->GetSubsystem<UAIPatrolSubsystem>())
+	{
+		// OnPatrolPathLoaded may already have run if the load completed inside the request, don't keep a finished handle
+		TSharedPtr<FStreamableHandle> Handle = PatrolSubsystem->RequestPatrolPathLoad(PatrolPath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPatrolPathLoaded));
+		if (Handle.IsValid() && !Handle->HasLoadCompleted())
+		{
+			PatrolPathLoadHandle = MoveTemp(Handle);
+		}
+	}
+}
+
+void AIsekaiAIController::OnPatrolPathLoaded()
+{
+	PatrolPathLoadHandle.Reset();
+	
+	if (!ControlledAICharacter.IsValid()) return;
+	
+	CachedPatrolPath = ControlledAICharacter->GetPatrolPath().Get();
+	if (!CachedPatrolPath.IsValid())
+	{
+		UE_LOG(LogIsekaiAI, Warning, TEXT("AIsekaiAIController::OnPatrolPathLoaded: Patrol path for %s failed to load"),
+			*ControlledAICharacter->GetName());
+		return;
+	}
+	
+	// Only an idle guard is sitting in the fallback of the skipped patrol branch. An alerted one keeps its branch,
+	// the patrol decorator passes once the tree returns to idle
+	const UBlackboardComponent* BB = GetBlackboardComponent();
+	if (!BB || BB->GetValueAsEnum(BBKeys::GStealthState) != static_cast<uint8>(EStealthState::Idle))
+	{
+		return;
+	}
+
+	// The patrol branch was skipped while the path was missing, re-run the tree so it gets picked up
+	if (UBehaviorTreeComponent* BTComp = Cast<UBehaviorTreeComponent>(BrainComponent))
+	{
+		BTComp->RestartTree();
+	}
+}
+
+void AIsekaiAIController::CancelPatrolPathLoad()
+{
+	if (PatrolPathLoadHandle.IsValid())
+	{
+		PatrolPathLoadHandle->CancelHandle();
+		PatrolPathLoadHandle.Reset();
+	}
+	
+	if (UAIPatrolSubsystem* PatrolSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UAIPatrolSubsystem>() : nullptr)
+	{
+		PatrolSubsystem->CancelPatrolPathWaits(this);
+	}
+}
+
 void AIsekaiAIController::OnTargetPerceptionUpdated(AActor* InTargetActor, FAIStimulus InStimulus)
+{
+	if (!HasAuthority() || !ControlledAICharacter.IsValid())
+	{
+		return;
+	}
+	
+	// Deferred to the per-world budget when registered, processed right away otherwise
+	if (UAIPerceptionBudgetSubsystem* PerceptionBudget = GetWorld()->GetSubsystem<UAIPerceptionBudgetSubsystem>();
+		PerceptionBudget && PerceptionBudget->QueueStimulus(this, InTargetActor, InStimulus))
+	{
+		return;
+	}
+	
+	ProcessPerceptionStimulus(InTargetActor, InStimulus);
+}
+
+void AIsekaiAIController::ProcessPerceptionStimulus(AActor* InTargetActor, const FAIStimulus& InStimulus)
 {
 	if (!HasAuthority() || !ControlledAICharacter.IsValid())
 	{
@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Runtime/AIModule/Classes/AIController.h"
+#include "AIAssessment/AI/IsekaiAITypes.h"
+#include "Engine/StreamableManager.h"
 #include "IsekaiAIController.generated.h"
 
 class AIsekaiPatrolPath;
+class UIsekaiPerceptionProfile;
 class UAIStealthComponent;
 struct FAIStimulus;
 class AIsekaiAICharacter;
@@ -24,10 +27,22 @@ class AIASSESSMENT_API AIsekaiAIController : public AAIController
 public:
 	AIsekaiAIController();
 
-	/** Stops behavior tree, perception, and other controller logic when the pawn dies. */
-	void HandlePawnDeath();
+	/**
+	 * Stops behavior tree, perception, and other controller logic when the pawn dies.
+	 * @param bDestroyController False keeps the controller alive so a pooled pawn can be re-possessed later.
+	 */
+	void HandlePawnDeath(bool bDestroyController = true);
 	
 	AIsekaiPatrolPath* GetPatrolPath() const { return CachedPatrolPath.Get(); }
+	
+	/** 
+	 * Throttles brain tick, perception senses, movement and animation for the given tier.
+	 * Called by UAISignificanceSubsystem on the server, all affected state is server-local or replicated by the engine.
+	 */
+	void ApplySignificanceTier(EIsekaiAISignificance Tier);
+	
+	/** Forwards a perception update to the pawn's stealth component. Called directly or by the perception budget. */
+	void ProcessPerceptionStimulus(AActor* InTargetActor, const FAIStimulus& InStimulus);
 
 protected:
 	// --- Actor Interface ---
@@ -43,9 +58,24 @@ protected:
 	
 private:
 	void SetupPerceptionSystem();
+	void SetPerceptionEnabled(bool bEnabled);
+	void SetSensesEnabled(bool bSightEnabled, bool bHearingEnabled);
+	/** Copies sense ranges from the profile into the sense configs and refreshes the listener. */
+	void ApplyPerceptionProfile(const UIsekaiPerceptionProfile* Profile);
 	void InitAIBehavior();
 	void ResetBlackboard();
 	
+	/** Caches the pawn's patrol path, streaming it in asynchronously if it is not resident yet. */
+	void RequestPatrolPath();
+	void OnPatrolPathLoaded();
+	void CancelPatrolPathLoad();
+	
 	TWeakObjectPtr<AIsekaiAICharacter> ControlledAICharacter;
 	TWeakObjectPtr<AIsekaiPatrolPath> CachedPatrolPath;
+	
+	TSharedPtr<FStreamableHandle> PatrolPathLoadHandle;
+	
+	/** Senses the current perception profile allows, significance tiers can only narrow these. */
+	bool bProfileSightEnabled = true;
+	bool bProfileHearingEnabled = true;
 };
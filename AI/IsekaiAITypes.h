@@ -15,6 +15,19 @@ enum class EStealthState : uint8
 	Alerted		UMETA(DisplayName="Alerted")
 };
 
+/** 
+ * AI level of detail, decided by distance to the closest player. Lower tiers throttle brain, perception, movement and animation.
+ */
+UENUM(BlueprintType)
+enum class EIsekaiAISignificance : uint8
+{
+	High		UMETA(DisplayName="High"),
+	Medium		UMETA(DisplayName="Medium"),
+	Low			UMETA(DisplayName="Low"),
+	Dormant		UMETA(DisplayName="Dormant"),
+	MAX			UMETA(Hidden)
+};
+
 UENUM(BlueprintType)
 enum EIsekaiTeamID : uint8
 {
@@ -0,0 +1,39 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiBehaviorTreeComponent.h"
+
+void UIsekaiBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	
+	ClampNextTick();
+}
+
+void UIsekaiBehaviorTreeComponent::SetMinTickInterval(const float Interval)
+{
+	const float NewInterval = FMath::Max(0.f, Interval);
+	if (NewInterval == MinTickInterval) return;
+	
+	const bool bPromoted = NewInterval < MinTickInterval;
+	MinTickInterval = NewInterval;
+	
+	// The current delay may have been clamped to the old interval, let the tree pick its own on the next frame
+	if (bPromoted && IsRunning())
+	{
+		ScheduleNextTick(0.f);
+	}
+	else
+	{
+		ClampNextTick();
+	}
+}
+
+void UIsekaiBehaviorTreeComponent::ClampNextTick()
+{
+	// FLT_MAX means the tree doesn't need to tick at all, that is never shortened
+	if (MinTickInterval <= 0.f || NextTickDeltaTime >= MinTickInterval) return;
+	
+	NextTickDeltaTime = MinTickInterval;
+	SetComponentTickIntervalAndCooldown(MinTickInterval);
+}
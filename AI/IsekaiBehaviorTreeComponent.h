@@ -0,0 +1,31 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "IsekaiBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component with a lower bound on its tick interval, set per significance tier.
+ * The tree reschedules its own tick after every update, so the component tick interval can't be set from outside.
+ * Instead the tree's requested delay is clamped, and the skipped time is still accumulated into the next update.
+ * Execution requests (aborts, finished latent tasks) still tick on the next frame.
+ */
+UCLASS()
+class AIASSESSMENT_API UIsekaiBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	
+	/** 0 lets the tree tick whenever it asks to. */
+	void SetMinTickInterval(float Interval);
+	float GetMinTickInterval() const { return MinTickInterval; }
+
+private:
+	void ClampNextTick();
+	
+	float MinTickInterval = 0.f;
+};
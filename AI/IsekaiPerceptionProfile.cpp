@@ -0,0 +1,4 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiPerceptionProfile.h"
@@ -0,0 +1,57 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "IsekaiPerceptionProfile.generated.h"
+
+/**
+ * Per-archetype perception tuning, applied by AIsekaiAIController on possession.
+ * Defaults match the values the controller used to hard-code, so a missing profile behaves as before.
+ */
+UCLASS(BlueprintType)
+class AIASSESSMENT_API UIsekaiPerceptionProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// --- Sight ---
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight")
+	bool bEnableSight = true;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSight"))
+	float SightRadius = 2000.f;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSight"))
+	float LoseSightRadius = 2200.f;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="deg", ClampMin="0.0", ClampMax="180.0", EditCondition="bEnableSight"))
+	float PeripheralVisionAngleDegrees = 100.f;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="cm", EditCondition="bEnableSight"))
+	float PointOfViewBackwardOffset = 50.f;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSight"))
+	float NearClippingRadius = 50.f;
+	
+	/** 0 = never expires. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Sight", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnableSight"))
+	float SightMaxAge = 0.f;
+	
+	// --- Hearing ---
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Hearing")
+	bool bEnableHearing = true;
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Hearing", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableHearing"))
+	float HearingRange = 3000.f;
+	
+	/** 0 = never expires. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Hearing", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnableHearing"))
+	float HearingMaxAge = 0.f;
+	
+	// --- Budget ---
+	/** Minimum time between two stimulus processing passes for an Idle listener. Reacting listeners are never throttled. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Budget", meta=(Unit="s", ClampMin="0.0"))
+	float StimulusProcessInterval = 0.f;
+};
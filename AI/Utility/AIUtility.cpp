@@ -4,6 +4,79 @@
 #include "AIUtility.h"
 
 #include "AIAssessment/AI/IsekaiAITypes.h"
+#include "AIAssessment/Character/IsekaiCharacterBase.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	/** Same team is Friendly, Player and Enemy are mutually Hostile, everything else is Neutral. */
+	constexpr FIsekaiTeamAttitudeTable MakeDefaultTeamAttitudeTable()
+	{
+		FIsekaiTeamAttitudeTable Table;
+		for (int32 A = 0; A < FIsekaiTeamAttitudeTable::MaxTeams; ++A)
+		{
+			for (int32 B = 0; B < FIsekaiTeamAttitudeTable::MaxTeams; ++B)
+			{
+				Table.Attitudes[A][B] = A == B ? ETeamAttitude::Friendly : ETeamAttitude::Neutral;
+			}
+		}
+		
+		// Explicit Hostilities
+		Table.Attitudes[EIsekaiTeamID::Player][EIsekaiTeamID::Enemy] = ETeamAttitude::Hostile;
+		Table.Attitudes[EIsekaiTeamID::Enemy][EIsekaiTeamID::Player] = ETeamAttitude::Hostile;
+		
+		return Table;
+	}
+	
+	ETeamAttitude::Type SolveTeamAttitude(const FGenericTeamId A, const FGenericTeamId B)
+	{
+		return FAIUtility::GetTeamAttitude(A, B);
+	}
+}
+
+static constexpr FIsekaiTeamAttitudeTable GDefaultTeamAttitudeTable = MakeDefaultTeamAttitudeTable();
+static_assert(GDefaultTeamAttitudeTable.Attitudes[EIsekaiTeamID::Player][EIsekaiTeamID::Enemy] == ETeamAttitude::Hostile);
+static_assert(GDefaultTeamAttitudeTable.Attitudes[EIsekaiTeamID::Neutral][EIsekaiTeamID::Enemy] == ETeamAttitude::Neutral);
+
+FIsekaiTeamAttitudeTable FAIUtility::AttitudeTable = GDefaultTeamAttitudeTable;
+
+void FIsekaiTeamAttitudeTable::Set(const uint8 A, const uint8 B, const ETeamAttitude::Type Attitude)
+{
+	if (A < MaxTeams && B < MaxTeams)
+	{
+		Attitudes[A][B] = static_cast<uint8>(Attitude);
+	}
+}
+
+void FAIUtility::RebuildTeamAttitudeTable()
+{
+	AttitudeTable = GDefaultTeamAttitudeTable;
+	
+	for (const FIsekaiTeamAttitudeOverride& Override : GetDefault<UIsekaiAISettings>()->TeamAttitudeOverrides)
+	{
+		if (Override.TeamA >= FIsekaiTeamAttitudeTable::MaxTeams || Override.TeamB >= FIsekaiTeamAttitudeTable::MaxTeams)
+		{
+			UE_LOG(LogIsekaiAI, Warning, TEXT("FAIUtility::RebuildTeamAttitudeTable: Ignoring override %d -> %d, only %d teams are supported"),
+				Override.TeamA, Override.TeamB, FIsekaiTeamAttitudeTable::MaxTeams);
+			continue;
+		}
+		
+		AttitudeTable.Set(Override.TeamA, Override.TeamB, Override.Attitude);
+		if (Override.bSymmetric)
+		{
+			AttitudeTable.Set(Override.TeamB, Override.TeamA, Override.Attitude);
+		}
+	}
+}
+
+void FAIUtility::InstallTeamAttitudeSolver()
+{
+	RebuildTeamAttitudeTable();
+	
+	FGenericTeamId::SetAttitudeSolver(SolveTeamAttitude);
+}
 
 ETeamAttitude::Type FAIUtility::GetTeamAttitude(const AActor* Self, const AActor* Other)
 {
@@ -18,10 +91,18 @@ ETeamAttitude::Type FAIUtility::GetTeamAttitude(const AActor* Self, const AActor
 	{
 		return ETeamAttitude::Friendly;
 	}
+	
+	// Fast path, both are characters, read the cached IDs without going through the interface
+	const AIsekaiCharacterBase* SelfChar = Cast<AIsekaiCharacterBase>(Self);
+	const AIsekaiCharacterBase* OtherChar = Cast<AIsekaiCharacterBase>(Other);
+	if (SelfChar && OtherChar)
+	{
+		return GetTeamAttitude(SelfChar->GetCachedTeamId(), OtherChar->GetCachedTeamId());
+	}
     
 	// Interface Checks
-	const IGenericTeamAgentInterface* SelfTeamAgent = Cast<const IGenericTeamAgentInterface>(Self);
-	const IGenericTeamAgentInterface* OtherTeamAgent = Cast<const IGenericTeamAgentInterface>(Other);
+	const IGenericTeamAgentInterface* SelfTeamAgent = SelfChar ? SelfChar : Cast<const IGenericTeamAgentInterface>(Self);
+	const IGenericTeamAgentInterface* OtherTeamAgent = OtherChar ? OtherChar : Cast<const IGenericTeamAgentInterface>(Other);
 
 	if (!SelfTeamAgent || !OtherTeamAgent)
 	{
@@ -29,21 +110,117 @@ ETeamAttitude::Type FAIUtility::GetTeamAttitude(const AActor* Self, const AActor
 		return ETeamAttitude::Neutral;
 	}
 
-	// Team ID Comparison
-	const uint8 SelfID = SelfTeamAgent->GetGenericTeamId().GetId();
-	const uint8 TheirID = OtherTeamAgent->GetGenericTeamId().GetId();
+	return GetTeamAttitude(SelfTeamAgent->GetGenericTeamId(), OtherTeamAgent->GetGenericTeamId());
+}
 
-	if (SelfID == TheirID)
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	/** The original cast-and-compare implementation, kept only as the benchmark baseline. */
+	ETeamAttitude::Type GetTeamAttitudeLegacy(const AActor* Self, const AActor* Other)
 	{
-		return ETeamAttitude::Friendly;
+		if (!IsValid(Self) || !IsValid(Other)) return ETeamAttitude::Neutral;
+		if (Self == Other) return ETeamAttitude::Friendly;
+		
+		const IGenericTeamAgentInterface* SelfTeamAgent = Cast<const IGenericTeamAgentInterface>(Self);
+		const IGenericTeamAgentInterface* OtherTeamAgent = Cast<const IGenericTeamAgentInterface>(Other);
+		if (!SelfTeamAgent || !OtherTeamAgent) return ETeamAttitude::Neutral;
+		
+		const uint8 SelfID = SelfTeamAgent->GetGenericTeamId().GetId();
+		const uint8 TheirID = OtherTeamAgent->GetGenericTeamId().GetId();
+		if (SelfID == TheirID) return ETeamAttitude::Friendly;
+		
+		if ((SelfID == EIsekaiTeamID::Player && TheirID == EIsekaiTeamID::Enemy) ||
+			(SelfID == EIsekaiTeamID::Enemy && TheirID == EIsekaiTeamID::Player))
+		{
+			return ETeamAttitude::Hostile;
+		}
+		return ETeamAttitude::Neutral;
 	}
+}
 
-	// Explicit Hostilities
-	if ((SelfID == EIsekaiTeamID::Player && TheirID == EIsekaiTeamID::Enemy) ||
-		(SelfID == EIsekaiTeamID::Enemy && TheirID == EIsekaiTeamID::Player))
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchTeamAttitude(
+	TEXT("Isekai.Team.BenchAttitude"),
+	TEXT("Times team attitude queries between every pair of characters in the world. Args: [Iterations=200]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
 	{
-		return ETeamAttitude::Hostile;
-	}
-
-	return ETeamAttitude::Neutral;
-}
\ No newline at end of file
+		if (!World) return;
+		
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+		
+		TArray<const AActor*> Actors;
+		for (TActorIterator<AIsekaiCharacterBase> It(World); It; ++It)
+		{
+			Actors.Add(*It);
+		}
+		if (Actors.Num() < 2)
+		{
+			UE_LOG(LogIsekaiAI, Warning, TEXT("Isekai.Team.BenchAttitude: Needs at least two characters in the world"));
+			return;
+		}
+		
+		TArray<FGenericTeamId> TeamIds;
+		for (const AActor* Actor : Actors)
+		{
+			TeamIds.Add(CastChecked<AIsekaiCharacterBase>(Actor)->GetCachedTeamId());
+		}
+		
+		const int64 NumQueries = static_cast<int64>(Iterations) * Actors.Num() * Actors.Num();
+		int32 Checksum[3] = {};
+		int32 Mismatches = 0;
+		
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			for (const AActor* A : Actors)
+			{
+				for (const AActor* B : Actors)
+				{
+					Checksum[0] += GetTeamAttitudeLegacy(A, B);
+				}
+			}
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+		
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			for (const AActor* A : Actors)
+			{
+				for (const AActor* B : Actors)
+				{
+					Checksum[1] += FAIUtility::GetTeamAttitude(A, B);
+				}
+			}
+		}
+		const double ActorSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			for (const FGenericTeamId A : TeamIds)
+			{
+				for (const FGenericTeamId B : TeamIds)
+				{
+					Checksum[2] += FAIUtility::GetTeamAttitude(A, B);
+				}
+			}
+		}
+		const double IdSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		// Same answers as the old code, unless designers overrode the defaults
+		for (const AActor* A : Actors)
+		{
+			for (const AActor* B : Actors)
+			{
+				Mismatches += GetTeamAttitudeLegacy(A, B) != FAIUtility::GetTeamAttitude(A, B) ? 1 : 0;
+			}
+		}
+		
+		UE_LOG(LogIsekaiAI, Log, TEXT("Isekai.Team.BenchAttitude: %d actors, %lld queries each"), Actors.Num(), NumQueries);
+		UE_LOG(LogIsekaiAI, Log, TEXT("  Legacy casts:  %.3f ms (%.2f ns/query)"), LegacySeconds * 1000.0, LegacySeconds * 1e9 / NumQueries);
+		UE_LOG(LogIsekaiAI, Log, TEXT("  Actor lookup:  %.3f ms (%.2f ns/query)"), ActorSeconds * 1000.0, ActorSeconds * 1e9 / NumQueries);
+		UE_LOG(LogIsekaiAI, Log, TEXT("  TeamId lookup: %.3f ms (%.2f ns/query)"), IdSeconds * 1000.0, IdSeconds * 1e9 / NumQueries);
+		UE_LOG(LogIsekaiAI, Log, TEXT("  Mismatches vs legacy: %d (checksums %d/%d/%d)"), Mismatches, Checksum[0], Checksum[1], Checksum[2]);
+	}));
+#endif
@@ -6,6 +6,25 @@
 #include "GenericTeamAgentInterface.h"
 
 
+/**
+ * Team attitude matrix indexed by raw team ID.
+ * The defaults are built at compile time from EIsekaiTeamID, designer overrides from UIsekaiAISettings are layered on top at startup.
+ */
+struct AIASSESSMENT_API FIsekaiTeamAttitudeTable
+{
+	/** Number of supported factions. IDs at or above this (including NoTeam) are Neutral to everyone. */
+	static constexpr int32 MaxTeams = 32;
+	
+	uint8 Attitudes[MaxTeams][MaxTeams] = {};
+	
+	FORCEINLINE ETeamAttitude::Type Get(const uint8 A, const uint8 B) const
+	{
+		return A < MaxTeams && B < MaxTeams ? static_cast<ETeamAttitude::Type>(Attitudes[A][B]) : ETeamAttitude::Neutral;
+	}
+	
+	void Set(uint8 A, uint8 B, ETeamAttitude::Type Attitude);
+};
+
 /**
  * 
  */
@@ -13,4 +32,19 @@ class AIASSESSMENT_API FAIUtility
 {
 public:
 	static ETeamAttitude::Type GetTeamAttitude(const AActor* Self, const AActor* Other);
+	
+	/** Constant time lookup, no casts. */
+	static FORCEINLINE ETeamAttitude::Type GetTeamAttitude(const FGenericTeamId SelfID, const FGenericTeamId OtherID)
+	{
+		return AttitudeTable.Get(SelfID.GetId(), OtherID.GetId());
+	}
+	
+	/** Resets the table to the compile time defaults and re-applies the settings overrides. */
+	static void RebuildTeamAttitudeTable();
+	
+	/** Routes FGenericTeamId::GetAttitude (used by AIPerception affiliation filtering) through the same table. */
+	static void InstallTeamAttitudeSolver();
+	
+private:
+	static FIsekaiTeamAttitudeTable AttitudeTable;
 };
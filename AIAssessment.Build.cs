@@ -16,6 +16,7 @@ public class AIAssessment : ModuleRules
 			"InputCore", 
 			"EnhancedInput",
 			"GameplayTags",
+			"NetCore",
 			"GameplayAbilities",
 			"GameplayTasks",
 			"UMG",
@@ -20,6 +20,8 @@ UGA_Crouch::UGA_Crouch()
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
 	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 	ActivationPolicy = OnInputTriggered;
+	// Pressing again while crouched stands up, that press must not crouch again afterwards
+	bBufferPressWhileActive = false;
 	
 	CancelAbilitiesWithTag.AddTag(Tags::Ability::Movement_Sprint);
 	BlockAbilitiesWithTag.AddTag(Tags::Ability::Movement_Sprint);
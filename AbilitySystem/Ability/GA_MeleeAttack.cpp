@@ -4,7 +4,9 @@
 #include "GA_MeleeAttack.h"
 
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
 #include "AIAssessment/NativeGameplayTags.h"
+#include "AIAssessment/AI/Utility/AIUtility.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "AbilitySystemBlueprintLibrary.h"
@@ -75,6 +77,8 @@ void UGA_MeleeAttack::OnEventReceived(FGameplayEventData EventData)
 
 void UGA_MeleeAttack::PerformAttackTrace()
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_MeleeAttackTrace);
+	
 	if (!GetOwningActorFromActorInfo()->HasAuthority()) return;
 
 	AActor* Avatar = GetAvatarActorFromActorInfo();
@@ -88,6 +92,7 @@ void UGA_MeleeAttack::PerformAttackTrace()
 	FCollisionQueryParams Params;
 	Params.AddIgnoredActor(Avatar);
 
+	ISEKAI_INC_COUNTER(STAT_Isekai_AttackTraces, 1);
 	const bool bHit = GetWorld()->SweepMultiByChannel(
 		OutHits, Start, End, FQuat::Identity, ECC_Pawn,
 		FCollisionShape::MakeSphere(AttackRadius), Params
@@ -159,21 +164,15 @@ void UGA_MeleeAttack::RotateTowardsBestTarget()
 
 	if (bHit)
 	{
-		const IGenericTeamAgentInterface* AvatarTeamAgent = Cast<IGenericTeamAgentInterface>(AvatarPawn);
-
 		for (const FHitResult& Hit : OutHits)
 		{
 			AActor* Target = Hit.GetActor();
 			if (!Target || Target == AvatarPawn) continue;
 
-			// Team Check: Ignore friends for auto-aim
-			if (AvatarTeamAgent)
+			// Team Check: Ignore friends for auto-aim, through the same attitude table as perception
+			if (FAIUtility::GetTeamAttitude(AvatarPawn, Target) == ETeamAttitude::Friendly)
 			{
-				const IGenericTeamAgentInterface* TargetTeamAgent = Cast<IGenericTeamAgentInterface>(Target);
-				if (TargetTeamAgent && TargetTeamAgent->GetGenericTeamId() == AvatarTeamAgent->GetGenericTeamId())
-				{
-					continue;
-				}
+				continue;
 			}
             
 			FVector DirToTarget = (Target->GetActorLocation() - Start).GetSafeNormal();
@@ -25,6 +25,15 @@ UIsekaiAbilitySystemComponent* UIsekaiGameplayAbility::GetIsekaiAbilitySystemCom
 	return ActorInfo ? Cast<UIsekaiAbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get()) : nullptr;
 }
 
+void UIsekaiGameplayAbility::GetActivationBlockingTags(FGameplayTagContainer& OutTags) const
+{
+	OutTags.AppendTags(ActivationBlockedTags);
+	if (const FGameplayTagContainer* CooldownTags = GetCooldownTags())
+	{
+		OutTags.AppendTags(*CooldownTags);
+	}
+}
+
 const UIsekaiAttributeSet* UIsekaiGameplayAbility::GetIsekaiAttributeSet() const
 {
 	if (const UIsekaiAbilitySystemComponent* IsekaiASC = GetIsekaiAbilitySystemComponent())
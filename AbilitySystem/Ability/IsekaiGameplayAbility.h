@@ -39,6 +39,12 @@ public:
 	/** Returns this ability's activation policy used by the custom ASC when processing input. */
 	EIsekaiAbilityActivationPolicy GetActivationPolicy() const { return ActivationPolicy; }
 	
+	/** Whether the ASC buffers a press that arrives while this ability runs, and activates it again once it ends. */
+	bool ShouldBufferPressWhileActive() const { return bBufferPressWhileActive && ActivationPolicy == OnInputTriggered; }
+	
+	/** Tags whose removal can let a refused activation through: the activation blocked tags and the cooldown tags. */
+	void GetActivationBlockingTags(FGameplayTagContainer& OutTags) const;
+	
 protected:
 	/** Typed convenience accessor for the owning Isekai character (AvatarActor). */
 	AIsekaiCharacterBase* GetIsekaiCharacter() const;
@@ -50,6 +56,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Isekai|Ability")
 	TEnumAsByte<EIsekaiAbilityActivationPolicy> ActivationPolicy = OnInputTriggered;
 	
+	/**
+	 * A running ability is never re-activated by input, so a press during it (e.g. an attack mid-montage) is buffered
+	 * and retried when it ends. Turn off for abilities that consume the press themselves, like a toggle.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Isekai|Ability", meta=(EditCondition="ActivationPolicy==EIsekaiAbilityActivationPolicy::OnInputTriggered"))
+	bool bBufferPressWhileActive = true;
+	
 	/**
 	 * Called when input is released for this ability.
 	 * For WhileInputActive abilities on the locally controlled pawn, this will end the ability.
@@ -5,6 +5,7 @@
 #include "GameplayEffectTypes.h"
 #include "AIAssessment/NativeGameplayTags.h"
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
+#include "AIAssessment/Subsystem/World/IsekaiRegenSubsystem.h"
 
 // --- Ctor & Overrides ---
 UIsekaiStaminaCostAbility::UIsekaiStaminaCostAbility()
@@ -48,6 +49,12 @@ bool UIsekaiStaminaCostAbility::CommitAbility(const FGameplayAbilitySpecHandle H
 	{
 		return false;
 	}
+	
+	// The attribute lags the integrated value, bring it up to date so the cost isn't applied on a stale base
+	if (UIsekaiRegenSubsystem* RegenSubsystem = GetRegenSubsystem())
+	{
+		RegenSubsystem->Flush(GetIsekaiAbilitySystemComponent());
+	}
 
 	// If the base commit was successful, apply our custom stamina cost.
 	if (!ApplyInitialStaminaCost())
@@ -91,6 +98,18 @@ bool UIsekaiStaminaCostAbility::ShouldSkipCost() const
     return false;
 }
 
+UIsekaiRegenSubsystem* UIsekaiStaminaCostAbility::GetRegenSubsystem() const
+{
+    const UIsekaiAbilitySystemComponent* IsekaiASC = GetIsekaiAbilitySystemComponent();
+    if (!IsekaiASC || !IsekaiASC->IsOwnerActorAuthoritative())
+    {
+        return nullptr;
+    }
+    
+    UIsekaiRegenSubsystem* RegenSubsystem = GetWorld()->GetSubsystem<UIsekaiRegenSubsystem>();
+    return RegenSubsystem && RegenSubsystem->IsRegistered(IsekaiASC) ? RegenSubsystem : nullptr;
+}
+
 // --- Stamina helpers ---
 bool UIsekaiStaminaCostAbility::HasEnoughStamina(const float RequiredStamina, const bool bAllowOverdraw) const
 {
@@ -100,7 +119,13 @@ bool UIsekaiStaminaCostAbility::HasEnoughStamina(const float RequiredStamina, co
         return false;
     }
     
-    const float CurrentStamina = IsekaiAS->GetStamina();
+    // The attribute lags the integrated value by up to a net write interval. Read-only, this runs from CanActivateAbility.
+    // Clients only see the attribute on corrections, the replicated trajectory is current
+    float CurrentStamina = IsekaiAS->GetCurrentStamina();
+    if (const UIsekaiRegenSubsystem* RegenSubsystem = GetRegenSubsystem())
+    {
+        RegenSubsystem->GetIntegratedValue(GetIsekaiAbilitySystemComponent(), EIsekaiRegenChannel::Stamina, CurrentStamina);
+    }
 
     if (RequiredStamina <= 0.0f)
     {
@@ -147,6 +172,20 @@ FActiveGameplayEffectHandle UIsekaiStaminaCostAbility::StartStaminaDrain()
     {
         return FActiveGameplayEffectHandle();
     }
+    
+    // Batched server-side drain, nothing to predict since periodic effects only execute on the server anyway
+    if (UIsekaiRegenSubsystem* RegenSubsystem = GetRegenSubsystem())
+    {
+        if (RegisteredDrainRate <= 0.f && RegenSubsystem->AddDrain(IsekaiASC, EIsekaiRegenChannel::Stamina, StaminaDrainPerSecond))
+        {
+            RegisteredDrainRate = StaminaDrainPerSecond;
+        }
+        return FActiveGameplayEffectHandle();
+    }
+    if (!IsekaiASC->IsOwnerActorAuthoritative() && UIsekaiRegenSubsystem::IsIntegrationEnabled())
+    {
+        return FActiveGameplayEffectHandle();
+    }
 
     // Determine the GE's tick period from its CDO, so we can convert per-second cost to per-tick.
     const UGameplayEffect* DrainGECDO = PeriodicStaminaDrainEffectClass->GetDefaultObject<UGameplayEffect>();
@@ -168,6 +207,15 @@ FActiveGameplayEffectHandle UIsekaiStaminaCostAbility::StartStaminaDrain()
 
 void UIsekaiStaminaCostAbility::StopAllStaminaCosts()
 {
+    if (RegisteredDrainRate > 0.f)
+    {
+        if (UIsekaiRegenSubsystem* RegenSubsystem = GetRegenSubsystem())
+        {
+            RegenSubsystem->RemoveDrain(GetIsekaiAbilitySystemComponent(), EIsekaiRegenChannel::Stamina, RegisteredDrainRate);
+        }
+        RegisteredDrainRate = 0.f;
+    }
+    
     if (!StaminaDrainEffectHandle.IsValid())
     {
         return;
@@ -183,6 +231,20 @@ void UIsekaiStaminaCostAbility::StopAllStaminaCosts()
 
 void UIsekaiStaminaCostAbility::ApplyStaminaRegenDelay() const
 {
+    if (UIsekaiRegenSubsystem* RegenSubsystem = GetRegenSubsystem())
+    {
+        RegenSubsystem->DelayRegen(GetIsekaiAbilitySystemComponent(), EIsekaiRegenChannel::Stamina);
+        return;
+    }
+    
+    // The server delays the integrated regen instead of applying the effect, a predicted one would never be confirmed.
+    // The delay reaches the client through the republished stamina trajectory
+    const UIsekaiAbilitySystemComponent* OwnerASC = GetIsekaiAbilitySystemComponent();
+    if (OwnerASC && !OwnerASC->IsOwnerActorAuthoritative() && UIsekaiRegenSubsystem::IsIntegrationEnabled())
+    {
+        return;
+    }
+    
     if (!StaminaRegenDelayEffectClass)
     {
         return;
@@ -197,25 +259,17 @@ void UIsekaiStaminaCostAbility::ApplyStaminaRegenDelay() const
     }
 
     const float Delay = IsekaiAS->GetStaminaRegenDelay();
+    const UGameplayEffect* DelayEffectDef = FIsekaiEffectSpecTemplateCache::GetEffectDef(StaminaRegenDelayEffectClass);
 
-    FGameplayEffectContextHandle Context = IsekaiASC->MakeEffectContext();
-    Context.AddSourceObject(this);
-
-    FGameplayEffectSpecHandle SpecHandle =
-        IsekaiASC->MakeOutgoingSpec(StaminaRegenDelayEffectClass, GetAbilityLevel(), Context);
-
-    if (!SpecHandle.IsValid())
+    // Rebuilt only when the delay attribute changed. A delay of 0 falls back to the effect's authored duration
+    FGameplayEffectSpec* Spec = SpecTemplates.FindOrBuildWithDuration(IsekaiASC, DelayEffectDef, GetAbilityLevel(), this, Delay);
+    if (!Spec)
     {
         return;
     }
 
-    if (Delay > 0.f)
-    {
-        SpecHandle.Data->SetDuration(Delay, /*bLockDuration*/ true);
-    }
-
     // GE will grant State.Stamina.RegenBlocked.Delay and auto-clear when it expires.
-    ApplyGameplayEffectSpecToOwner(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, SpecHandle);
+    ApplySpecTemplateToOwner(*Spec);
 }
 
 void UIsekaiStaminaCostAbility::SetRegenBlockedByActiveAbility(bool bBlocked) const
@@ -252,22 +306,18 @@ FActiveGameplayEffectHandle UIsekaiStaminaCostAbility::ApplyStaminaCostEffectInt
         return FActiveGameplayEffectHandle();
     }
 
-    FGameplayEffectContextHandle Context = IsekaiASC->MakeEffectContext();
-    Context.AddSourceObject(this);
+    FGameplayEffectSpec* Spec =
+        SpecTemplates.FindOrBuild(IsekaiASC, FIsekaiEffectSpecTemplateCache::GetEffectDef(EffectClass), GetAbilityLevel(), this);
 
-    const FGameplayEffectSpecHandle SpecHandle =
-        IsekaiASC->MakeOutgoingSpec(EffectClass, GetAbilityLevel(), Context);
-
-    if (!SpecHandle.IsValid())
+    if (!Spec)
     {
         return FActiveGameplayEffectHandle();
     }
 
     // We treat CostMagnitude as a positive number, but the GE expects a negative modifier to reduce Stamina.
-    SpecHandle.Data->SetSetByCallerMagnitude(Tags::Data::Cost_Stamina, -CostMagnitude); // so we negate here
+    Spec->SetSetByCallerMagnitude(Tags::Data::Cost_Stamina, -CostMagnitude); // so we negate here
 
-    FActiveGameplayEffectHandle Handle =
-        ApplyGameplayEffectSpecToOwner(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, SpecHandle);
+    FActiveGameplayEffectHandle Handle = ApplySpecTemplateToOwner(*Spec);
 
 
     if (!Handle.WasSuccessfullyApplied())
@@ -283,3 +333,14 @@ FActiveGameplayEffectHandle UIsekaiStaminaCostAbility::ApplyStaminaCostEffectInt
     return Handle;
 }
 
+FActiveGameplayEffectHandle UIsekaiStaminaCostAbility::ApplySpecTemplateToOwner(const FGameplayEffectSpec& Spec) const
+{
+    UAbilitySystemComponent* ASC = CurrentActorInfo ? CurrentActorInfo->AbilitySystemComponent.Get() : nullptr;
+    if (!ASC || !HasAuthorityOrPredictionKey(CurrentActorInfo, &CurrentActivationInfo))
+    {
+        return FActiveGameplayEffectHandle();
+    }
+
+    // Applying copies the spec, so the template can be patched again right away
+    return ASC->ApplyGameplayEffectSpecToSelf(Spec, ASC->GetPredictionKeyForNewAction());
+}
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "IsekaiGameplayAbility.h"
+#include "AIAssessment/AbilitySystem/IsekaiEffectSpecTemplateCache.h"
 #include "IsekaiStaminaCostAbility.generated.h"
 
+class UIsekaiRegenSubsystem;
+
 /**
  * Base class for any ability that spends stamina or reacts to stamina/exhaustion state.
  *
@@ -49,11 +52,11 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Stamina")
     TSubclassOf<UGameplayEffect> InstantStaminaCostEffectClass;
 
-    /** GE used for periodic stamina drain (expects SetByCaller(Data.Cost.Stamina), Periodic). */
+    /** GE used for periodic stamina drain (expects SetByCaller(Data.Cost.Stamina), Periodic). Only used when regen integration is disabled. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Stamina")
     TSubclassOf<UGameplayEffect> PeriodicStaminaDrainEffectClass;
 
-    /** GE that blocks stamina regen for StaminaRegenDelay seconds (grants State.Stamina.RegenBlocked.Delay). */
+    /** GE that blocks stamina regen for StaminaRegenDelay seconds (grants State.Stamina.RegenBlocked.Delay). Only used when regen integration is disabled. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Stamina")
     TSubclassOf<UGameplayEffect> StaminaRegenDelayEffectClass;
 	
@@ -67,6 +70,9 @@ protected:
 	
 	bool ShouldSkipCost() const;
 	
+	/** Server-side regen integrator tracking this ability's ASC, null on clients or when it is not tracked. */
+	UIsekaiRegenSubsystem* GetRegenSubsystem() const;
+	
     // --- Stamina helpers ---
 
     /** Returns true if current stamina can afford RequiredStamina (optionally allowing overdraw). */
@@ -75,7 +81,7 @@ protected:
     /** Applies InitialStaminaCost once; returns true on success or if no initial cost is configured. */
     bool ApplyInitialStaminaCost();
 
-    /** Starts a periodic stamina drain effect and tracks its handle. */
+    /** Registers the drain rate with the regen subsystem, or starts a periodic stamina drain effect and tracks its handle. */
     FActiveGameplayEffectHandle StartStaminaDrain();
 
     /** Stops all active stamina cost effects applied by this ability instance. */
@@ -94,9 +100,18 @@ protected:
         bool bTrackHandle
     );
 
+    /** ApplyGameplayEffectSpecToOwner for a cached template spec, which has no spec handle. */
+    FActiveGameplayEffectHandle ApplySpecTemplateToOwner(const FGameplayEffectSpec& Spec) const;
+
     // --- Internal state ---
 
     /** Handle for the active periodic stamina drain effect, if any. */
     UPROPERTY(Transient)
     FActiveGameplayEffectHandle StaminaDrainEffectHandle;
+
+    /** Drain rate currently registered with the regen subsystem, 0 if none. */
+    float RegisteredDrainRate = 0.f;
+
+    /** Cost and regen-delay specs, built on first commit and patched for every later one. Mutable for the const regen-delay path. */
+    mutable FIsekaiEffectSpecTemplateCache SpecTemplates;
 };
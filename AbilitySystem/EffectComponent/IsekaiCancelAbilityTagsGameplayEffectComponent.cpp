@@ -4,6 +4,21 @@
 #include "IsekaiCancelAbilityTagsGameplayEffectComponent.h"
 
 #include "AbilitySystemComponent.h"
+#include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
+
+namespace
+{
+	void CancelAbilitiesWithTags(UAbilitySystemComponent* ASC, const FGameplayTagContainer& TagsToCancel)
+	{
+		// Isekai ASCs only visit active abilities carrying the tags
+		if (UIsekaiAbilitySystemComponent* IsekaiASC = Cast<UIsekaiAbilitySystemComponent>(ASC))
+		{
+			IsekaiASC->CancelActiveAbilitiesWithTags(TagsToCancel);
+			return;
+		}
+		ASC->CancelAbilities(&TagsToCancel);
+	}
+}
 
 bool UIsekaiCancelAbilityTagsGameplayEffectComponent::OnActiveGameplayEffectAdded(
 	FActiveGameplayEffectsContainer& ActiveGEContainer, FActiveGameplayEffect& ActiveGE) const
@@ -30,14 +45,14 @@ bool UIsekaiCancelAbilityTagsGameplayEffectComponent::OnActiveGameplayEffectAdde
 	// 1 Server
 	if (bIsAuthority)
 	{
-		ASC->CancelAbilities(&TagsToCancel);
+		CancelAbilitiesWithTags(ASC, TagsToCancel);
 		return true;
 	}
 	
 	// 2 Client (local prediction)
 	if (bIsLocallyControlled)
 	{
-		ASC->CancelAbilities(&TagsToCancel);
+		CancelAbilitiesWithTags(ASC, TagsToCancel);
 	}
 	
 	return true;
@@ -6,7 +6,32 @@
 #include "ActiveGameplayEffectHandle.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "IsekaiAbilitySystemComponent.h"
+#include "GameplayEffectAggregator.h"
 #include "Ability/IsekaiGameplayAbility.h"
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "Engine/AssetManager.h"
+
+namespace
+{
+	/** Returns the loaded class, loading it synchronously if the set was not preloaded. */
+	template <typename T>
+	TSubclassOf<T> ResolveGrantedClass(const TSoftClassPtr<T>& SoftClass, const UIsekaiAbilitySet* AbilitySet)
+	{
+		if (SoftClass.IsNull())
+		{
+			return nullptr;
+		}
+		
+		if (UClass* LoadedClass = SoftClass.Get())
+		{
+			return LoadedClass;
+		}
+		
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("UIsekaiAbilitySet: %s from %s was not preloaded, loading synchronously"),
+			*SoftClass.ToString(), *GetNameSafe(AbilitySet));
+		return SoftClass.LoadSynchronous();
+	}
+}
 
 void FIsekaiAbilitySetGrantedHandles::AddAbilitySpecHandle(const FGameplayAbilitySpecHandle& Handle)
 {
@@ -70,6 +95,59 @@ void FIsekaiAbilitySetGrantedHandles::TakeFromAbilitySystem(UIsekaiAbilitySystem
 	}
 }
 
+void FIsekaiAbilitySetGrantedHandles::RemoveEffectsFromAbilitySystem(UIsekaiAbilitySystemComponent* AbilitySystemComponent)
+{
+	if (!AbilitySystemComponent || !AbilitySystemComponent->IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+	
+	for (const FActiveGameplayEffectHandle& Handle : EffectHandles)
+	{
+		if (Handle.IsValid())
+		{
+			AbilitySystemComponent->RemoveActiveGameplayEffect(Handle);
+		}
+	}
+	EffectHandles.Reset();
+}
+
+FGameplayAbilitySpecHandle FIsekaiAbilitySetGrantedHandles::FindReusableAbilitySpec(const UIsekaiAbilitySystemComponent* AbilitySystemComponent,
+	const TSubclassOf<UIsekaiGameplayAbility> AbilityClass, const int32 AbilityLevel, const FGameplayTag& InputTag, const UObject* SourceObject,
+	const TSet<FGameplayAbilitySpecHandle>& ClaimedHandles) const
+{
+	for (const FGameplayAbilitySpecHandle& Handle : AbilitySpecHandles)
+	{
+		if (ClaimedHandles.Contains(Handle))
+		{
+			continue;
+		}
+		
+		// Specs given under the current ability list lock aren't listed yet, so a batch never matches its own grants
+		const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromHandle(Handle);
+		if (!Spec || !Spec->Ability || Spec->Ability->GetClass() != AbilityClass || Spec->Level != AbilityLevel || Spec->SourceObject.Get() != SourceObject)
+		{
+			continue;
+		}
+		
+		const FGameplayTagContainer& SourceTags = Spec->GetDynamicSpecSourceTags();
+		const bool bSameInput = InputTag.IsValid() ? (SourceTags.Num() == 1 && SourceTags.HasTagExact(InputTag)) : SourceTags.IsEmpty();
+		if (bSameInput)
+		{
+			return Handle;
+		}
+	}
+	return FGameplayAbilitySpecHandle();
+}
+
+bool FIsekaiAbilitySetGrantedHandles::HasGrantedAttributeSet(const TSubclassOf<UAttributeSet> AttributeSetClass) const
+{
+	return GrantedAttributeSets.ContainsByPredicate([AttributeSetClass](const UAttributeSet* AttributeSet)
+	{
+		return AttributeSet && AttributeSet->GetClass() == AttributeSetClass;
+	});
+}
+
 void FIsekaiAbilitySetGrantedHandles::Reset()
 {
 	AbilitySpecHandles.Reset();
@@ -79,12 +157,92 @@ void FIsekaiAbilitySetGrantedHandles::Reset()
 
 void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 	FIsekaiAbilitySetGrantedHandles* OutGrantedHandles, UObject* SourceObject) const
+{
+	const TObjectPtr<UIsekaiAbilitySet> Self = const_cast<UIsekaiAbilitySet*>(this);
+	GiveAbilitySetsToAbilitySystem(MakeArrayView(&Self, 1), ASC, OutGrantedHandles, SourceObject);
+}
+
+void UIsekaiAbilitySet::GiveAbilitySetsToAbilitySystem(const TConstArrayView<TObjectPtr<UIsekaiAbilitySet>> AbilitySets,
+	UIsekaiAbilitySystemComponent* ASC, FIsekaiAbilitySetGrantedHandles* OutGrantedHandles, UObject* SourceObject)
 {
 	if (!ASC || !ASC->IsOwnerActorAuthoritative())
 	{
 		return;
 	}
 	
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumGrants = 0;
+	
+	{
+		// Released in reverse order: pending abilities are added when the list lock ends, then aggregators broadcast once
+		FScopedAggregatorOnDirtyBatch AggregatorBatch;
+		FScopedAbilityListLock AbilityListLock(*ASC);
+		
+		// Existing specs reused by this batch, so two identical grants don't both resolve to the same spec
+		TSet<FGameplayAbilitySpecHandle> ReusedAbilitySpecs;
+		for (const UIsekaiAbilitySet* AbilitySet : AbilitySets)
+		{
+			if (AbilitySet)
+			{
+				NumGrants += AbilitySet->GiveToAbilitySystemBatched(ASC, OutGrantedHandles, SourceObject, ReusedAbilitySpecs);
+			}
+		}
+	}
+	
+	if (NumGrants > 0)
+	{
+		ASC->ForceReplication();
+	}
+	
+	UE_LOG(LogIsekaiAbilitySystem, Verbose, TEXT("UIsekaiAbilitySet::GiveAbilitySetsToAbilitySystem: %d grants from %d sets to %s in %.3f ms"),
+		NumGrants, AbilitySets.Num(), *GetNameSafe(ASC->GetOwner()), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+TSharedPtr<FStreamableHandle> UIsekaiAbilitySet::LoadAbilitySetsAsync(const TConstArrayView<TObjectPtr<UIsekaiAbilitySet>> AbilitySets, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const UIsekaiAbilitySet* AbilitySet : AbilitySets)
+	{
+		if (AbilitySet)
+		{
+			AbilitySet->GetUnloadedClassPaths(PathsToLoad);
+		}
+	}
+	
+	if (PathsToLoad.Num() == 0)
+	{
+		OnLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+	
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToLoad), MoveTemp(OnLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UIsekaiAbilitySet::GetUnloadedClassPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const FIsekaiGrantedAbility& AbilityInfo : Abilities)
+	{
+		if (!AbilityInfo.AbilityClass.IsNull() && !AbilityInfo.AbilityClass.IsValid())
+		{
+			OutPaths.AddUnique(AbilityInfo.AbilityClass.ToSoftObjectPath());
+		}
+	}
+	
+	for (const FIsekaiGrantedEffect& EffectInfo : Effects)
+	{
+		if (!EffectInfo.EffectClass.IsNull() && !EffectInfo.EffectClass.IsValid())
+		{
+			OutPaths.AddUnique(EffectInfo.EffectClass.ToSoftObjectPath());
+		}
+	}
+}
+
+int32 UIsekaiAbilitySet::GiveToAbilitySystemBatched(UIsekaiAbilitySystemComponent* ASC,
+	FIsekaiAbilitySetGrantedHandles* OutGrantedHandles, UObject* SourceObject, TSet<FGameplayAbilitySpecHandle>& ReusedAbilitySpecs) const
+{
+	int32 NumGrants = 0;
+	
 	// Attribute Sets
 	for (const FIsekaiGrantedAttributeSet& AttributeSetInfo : AttributeSets)
 	{
@@ -93,9 +251,15 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 			continue;
 		}
 		
+		if (OutGrantedHandles && OutGrantedHandles->HasGrantedAttributeSet(AttributeSetInfo.AttributeSetClass))
+		{
+			continue;
+		}
+		
 		UAttributeSet* NewSet = NewObject<UAttributeSet>(ASC->GetOwner(), AttributeSetInfo.AttributeSetClass);
 		
 		ASC->AddAttributeSetSubobject(NewSet);
+		++NumGrants;
 		
 		if (OutGrantedHandles)
 		{
@@ -106,15 +270,27 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 	// Abilities
 	for (const FIsekaiGrantedAbility& AbilityInfo : Abilities)
 	{
-		if (!*AbilityInfo.AbilityClass)
+		const TSubclassOf<UIsekaiGameplayAbility> AbilityClass = ResolveGrantedClass(AbilityInfo.AbilityClass, this);
+		if (!AbilityClass)
 		{
 			continue;
 		}
 		
 		const int32 AbilityLevel = FMath::Max(1, AbilityInfo.AbilityLevel);
 		
+		// Reuse the matching spec when regranting through the same handles (e.g. pooled AI)
+		if (OutGrantedHandles)
+		{
+			const FGameplayAbilitySpecHandle ReusedHandle = OutGrantedHandles->FindReusableAbilitySpec(ASC, AbilityClass, AbilityLevel, AbilityInfo.InputTag, SourceObject, ReusedAbilitySpecs);
+			if (ReusedHandle.IsValid())
+			{
+				ReusedAbilitySpecs.Add(ReusedHandle);
+				continue;
+			}
+		}
+		
 		FGameplayAbilitySpec AbilitySpec(
-			AbilityInfo.AbilityClass, 
+			AbilityClass, 
 			AbilityLevel, 
 			INDEX_NONE, 
 			SourceObject);
@@ -125,6 +301,7 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 		}
 		
 		const FGameplayAbilitySpecHandle SpecHandle = ASC->GiveAbility(AbilitySpec);
+		++NumGrants;
 		
 		if (OutGrantedHandles)
 		{
@@ -135,7 +312,8 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 	// Effects
 	for (const FIsekaiGrantedEffect& EffectInfo : Effects)
 	{
-		if (!*EffectInfo.EffectClass)
+		const TSubclassOf<UGameplayEffect> EffectClass = ResolveGrantedClass(EffectInfo.EffectClass, this);
+		if (!EffectClass)
 		{
 			continue;
 		}
@@ -149,12 +327,13 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 		const float EffectLevel = FMath::Max(1, EffectInfo.EffectLevel);
 		
 		FGameplayEffectSpecHandle SpecHandle =
-			ASC->MakeOutgoingSpec(EffectInfo.EffectClass, EffectLevel, ContextHandle);
+			ASC->MakeOutgoingSpec(EffectClass, EffectLevel, ContextHandle);
 		
 		if (SpecHandle.IsValid())
 		{
 			FActiveGameplayEffectHandle EffectHandle =
 				ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+			++NumGrants;
 			
 			if (OutGrantedHandles && EffectHandle.IsValid())
 			{
@@ -162,4 +341,6 @@ void UIsekaiAbilitySet::GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC,
 			}
 		}
 	}
+	
+	return NumGrants;
 }
@@ -3,17 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayAbilitySpecHandle.h"
 #include "GameplayTagContainer.h"
 #include "Engine/DataAsset.h"
+#include "Engine/StreamableManager.h"
 #include "IsekaiAbilitySet.generated.h"
 
 class UIsekaiAbilitySystemComponent;
+class UIsekaiGameplayAbility;
 class UAttributeSet;
 struct FActiveGameplayEffectHandle;
-struct FGameplayAbilitySpecHandle;
 
 /**
- * A Single Ability to grant with level and optional input binding
+ * A Single Ability to grant with level and optional input binding.
+ * Soft, so loading a set doesn't pull in every ability; preload with UIsekaiAbilitySet::LoadAbilitySetsAsync.
  */
 USTRUCT(BlueprintType)
 struct FIsekaiGrantedAbility
@@ -21,7 +24,7 @@ struct FIsekaiGrantedAbility
 	GENERATED_BODY()
 public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability")
-	TSubclassOf<class UIsekaiGameplayAbility> AbilityClass = nullptr;
+	TSoftClassPtr<class UIsekaiGameplayAbility> AbilityClass;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability")
 	int32 AbilityLevel = 1;
@@ -37,7 +40,7 @@ struct FIsekaiGrantedEffect
 	GENERATED_BODY()
 public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
-	TSubclassOf<class UGameplayEffect> EffectClass = nullptr;
+	TSoftClassPtr<class UGameplayEffect> EffectClass;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
 	int32 EffectLevel = 1;
@@ -66,7 +69,17 @@ struct FIsekaiAbilitySetGrantedHandles
 	void AddAttributeSet(UAttributeSet* AttributeSet);
 	
 	void TakeFromAbilitySystem(UIsekaiAbilitySystemComponent* AbilitySystemComponent);
+	/** Removes only the granted effects, abilities and attribute sets stay granted for reuse. */
+	void RemoveEffectsFromAbilitySystem(UIsekaiAbilitySystemComponent* AbilitySystemComponent);
 	void Reset();
+	
+	/**
+	 * Returns a spec still granted through these handles with the same class, level, input tag and source, skipping
+	 * the ones in ClaimedHandles. Each existing spec stands in for exactly one grant, so duplicates are granted again.
+	 */
+	FGameplayAbilitySpecHandle FindReusableAbilitySpec(const UIsekaiAbilitySystemComponent* AbilitySystemComponent, TSubclassOf<UIsekaiGameplayAbility> AbilityClass,
+		int32 AbilityLevel, const FGameplayTag& InputTag, const UObject* SourceObject, const TSet<FGameplayAbilitySpecHandle>& ClaimedHandles) const;
+	bool HasGrantedAttributeSet(TSubclassOf<UAttributeSet> AttributeSetClass) const;
 };	
 
 
@@ -92,10 +105,35 @@ public:
 	 * Only valid to call on the authority owning the ASC.
 	 *
 	 * @param ASC                Target ability system component.
-	 * @param OutGrantedHandles  Optional handle container to allow removal later.
+	 * @param OutGrantedHandles  Optional handle container to allow removal later. Abilities and attribute sets
+	 *                           still granted through it are reused instead of granted again.
 	 * @param SourceObject       Optional source object (e.g. PlayerState, equipment).
 	 */
 	void GiveToAbilitySystem(UIsekaiAbilitySystemComponent* ASC, 
 		FIsekaiAbilitySetGrantedHandles* OutGrantedHandles = nullptr, 
 		UObject* SourceObject = nullptr) const;
+	
+	/**
+	 * Grants several sets as one batch: abilities are given under a single ability list lock, aggregator dirty
+	 * callbacks are batched across all effects, and the ASC is force-replicated once at the end.
+	 * Classes that were not preloaded are loaded synchronously, with a warning.
+	 */
+	static void GiveAbilitySetsToAbilitySystem(TConstArrayView<TObjectPtr<UIsekaiAbilitySet>> AbilitySets,
+		UIsekaiAbilitySystemComponent* ASC,
+		FIsekaiAbilitySetGrantedHandles* OutGrantedHandles = nullptr,
+		UObject* SourceObject = nullptr);
+	
+	/**
+	 * Loads every ability and effect class of the sets in one streamable request.
+	 * If everything is already loaded, OnLoaded runs immediately and nullptr is returned.
+	 */
+	static TSharedPtr<FStreamableHandle> LoadAbilitySetsAsync(TConstArrayView<TObjectPtr<UIsekaiAbilitySet>> AbilitySets, FStreamableDelegate OnLoaded = FStreamableDelegate());
+	
+	/** Adds the soft class paths of this set that are not loaded yet. */
+	void GetUnloadedClassPaths(TArray<FSoftObjectPath>& OutPaths) const;
+	
+private:
+	/** Grants without locking or flushing, see GiveAbilitySetsToAbilitySystem. Returns the number of grants. */
+	int32 GiveToAbilitySystemBatched(UIsekaiAbilitySystemComponent* ASC, FIsekaiAbilitySetGrantedHandles* OutGrantedHandles,
+		UObject* SourceObject, TSet<FGameplayAbilitySpecHandle>& ReusedAbilitySpecs) const;
 };
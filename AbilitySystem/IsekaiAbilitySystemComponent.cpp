@@ -6,6 +6,12 @@
 #include "Ability/IsekaiGameplayAbility.h"
 #include "AIAssessment/NativeGameplayTags.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
+#include "AIAssessment/Development/IsekaiTelemetry.h"
+#include "AbilitySystemGlobals.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 // --- Ctor & Overrides ---
 UIsekaiAbilitySystemComponent::UIsekaiAbilitySystemComponent()
@@ -13,6 +19,131 @@ UIsekaiAbilitySystemComponent::UIsekaiAbilitySystemComponent()
 
 }
 
+void UIsekaiAbilitySystemComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	// A running ability ending clears most blocks, blocking tags are only listened to while something is buffered
+	AbilityEndedCallbacks.AddUObject(this, &ThisClass::OnAnyAbilityEnded);
+}
+
+void UIsekaiAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+	
+	AddToInputTagIndex(AbilitySpec);
+	
+	FInputSpecCacheEntry& CacheEntry = InputSpecCache.FindOrAdd(AbilitySpec.Handle);
+	if (const UIsekaiGameplayAbility* AbilityCDO = Cast<UIsekaiGameplayAbility>(AbilitySpec.Ability))
+	{
+		CacheEntry.ActivationPolicy = AbilityCDO->GetActivationPolicy();
+		CacheEntry.bBufferPressWhileActive = AbilityCDO->ShouldBufferPressWhileActive();
+	}
+	bInputSpecIndicesDirty = true;
+}
+
+void UIsekaiAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	RemoveFromInputTagIndex(AbilitySpec);
+	InputSpecCache.Remove(AbilitySpec.Handle);
+	bInputSpecIndicesDirty = true;
+	
+	// A removed ability must not be re-activated by a held input
+	InputPressedSpecHandles.Remove(AbilitySpec.Handle);
+	InputReleasedSpecHandles.Remove(AbilitySpec.Handle);
+	InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+	
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void UIsekaiAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
+{
+	Super::NotifyAbilityActivated(Handle, Ability);
+	
+	if (!Ability)
+	{
+		return;
+	}
+	
+	ISEKAI_TELEMETRY_EVENT(AbilityActivated, GetAvatarActor(), nullptr, Ability->GetClass()->GetFName(), Ability->GetAbilityLevel());
+	
+	for (const FGameplayTag& Tag : Ability->GetAssetTags().GetGameplayTagParents())
+	{
+		ActiveAbilityTagIndex.FindOrAdd(Tag).Add(Handle);
+	}
+}
+
+void UIsekaiAbilitySystemComponent::NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled)
+{
+	if (Ability)
+	{
+		for (const FGameplayTag& Tag : Ability->GetAssetTags().GetGameplayTagParents())
+		{
+			if (auto* Handles = ActiveAbilityTagIndex.Find(Tag))
+			{
+				Handles->RemoveSingleSwap(Handle, EAllowShrinking::No);
+				if (Handles->IsEmpty())
+				{
+					ActiveAbilityTagIndex.Remove(Tag);
+				}
+			}
+		}
+	}
+	
+	Super::NotifyAbilityEnded(Handle, Ability, bWasCancelled);
+}
+
+FActiveGameplayEffectHandle UIsekaiAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, const FPredictionKey PredictionKey)
+{
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_ApplyEffectSpec);
+	ISEKAI_INC_COUNTER(STAT_Isekai_EffectApplications, 1);
+	
+	return Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+}
+
+void UIsekaiAbilitySystemComponent::CancelActiveAbilitiesWithTags(const FGameplayTagContainer& WithTags, UGameplayAbility* Ignore)
+{
+	// Collect first, canceling ends abilities and edits the index
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> CandidateHandles;
+	for (const FGameplayTag& Tag : WithTags)
+	{
+		if (const auto* Handles = ActiveAbilityTagIndex.Find(Tag))
+		{
+			for (const FGameplayAbilitySpecHandle& Handle : *Handles)
+			{
+				CandidateHandles.AddUnique(Handle);
+			}
+		}
+	}
+	
+	if (CandidateHandles.IsEmpty())
+	{
+		return;
+	}
+	
+	ABILITYLIST_SCOPE_LOCK();
+	for (const FGameplayAbilitySpecHandle& Handle : CandidateHandles)
+	{
+		EIsekaiAbilityActivationPolicy ActivationPolicy;
+		FGameplayAbilitySpec* Spec = FindInputSpec(Handle, ActivationPolicy);
+		if (Spec && Spec->IsActive() && Spec->Ability && Spec->Ability->GetAssetTags().HasAny(WithTags))
+		{
+			CancelAbilitySpec(*Spec, Ignore);
+		}
+	}
+}
+
+void UIsekaiAbilitySystemComponent::ApplyAbilityBlockAndCancelTags(const FGameplayTagContainer& AbilityTags, UGameplayAbility* RequestingAbility, const bool bEnableBlockTags, const FGameplayTagContainer& BlockTags, const bool bExecuteCancelTags, const FGameplayTagContainer& CancelTags)
+{
+	// Blocking only bumps tag counts checked on activation, nothing to index there
+	Super::ApplyAbilityBlockAndCancelTags(AbilityTags, RequestingAbility, bEnableBlockTags, BlockTags, false, CancelTags);
+	
+	if (bExecuteCancelTags && !CancelTags.IsEmpty())
+	{
+		CancelActiveAbilitiesWithTags(CancelTags, RequestingAbility);
+	}
+}
+
 void UIsekaiAbilitySystemComponent::AbilitySpecInputPressed(FGameplayAbilitySpec& Spec)
 {
 	Super::AbilitySpecInputPressed(Spec);
@@ -48,7 +179,7 @@ void UIsekaiAbilitySystemComponent::AbilitySpecInputReleased(FGameplayAbilitySpe
 }
 
 // --- Public API ---
-void UIsekaiAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
+void UIsekaiAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag, const uint32 TraceId)
 {
 	if (!InputTag.IsValid())
 	{
@@ -56,26 +187,24 @@ void UIsekaiAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& I
 		return;
 	}
 	
-	ABILITYLIST_SCOPE_LOCK();
-	
-	int32 MatchedAbilities = 0;
-
-	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	if (const auto* BoundHandles = InputTagToSpecHandles.Find(InputTag))
 	{
-		if (!AbilitySpec.Ability)
-		{
-			continue;
-		}
+		InputPressedTags.AddUnique(InputTag);
 		
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		for (const FGameplayAbilitySpecHandle& SpecHandle : *BoundHandles)
 		{
-			MatchedAbilities++;
-			InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-			InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+			InputPressedSpecHandles.AddUnique(SpecHandle);
+			InputHeldSpecHandles.AddUnique(SpecHandle);
+			
+#if ISEKAI_INPUT_LATENCY_TRACE
+			if (TraceId != 0)
+			{
+				PendingInputTraces.Emplace(SpecHandle, TraceId);
+			}
+#endif
 		}
 	}
-
-	if (MatchedAbilities == 0)
+	else
 	{
 		UE_LOG(LogIsekaiAbilitySystem, Verbose,
 			TEXT("AbilityInputTagPressed: No abilities bound to input tag %s on %s"),
@@ -92,26 +221,18 @@ void UIsekaiAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag&
 		return;
 	}
 	
-	ABILITYLIST_SCOPE_LOCK();
-
-	int32 MatchedAbilities = 0;
-
-	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	// A released press is no longer wanted, even if its ability would become possible later
+	RemoveBufferedInput(InputTag);
+	
+	if (const auto* BoundHandles = InputTagToSpecHandles.Find(InputTag))
 	{
-		if (!AbilitySpec.Ability)
-		{
-			continue;
-		}
-
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		for (const FGameplayAbilitySpecHandle& SpecHandle : *BoundHandles)
 		{
-			MatchedAbilities++;
-			InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-			InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+			InputReleasedSpecHandles.AddUnique(SpecHandle);
+			InputHeldSpecHandles.Remove(SpecHandle);
 		}
 	}
-
-	if (MatchedAbilities == 0)
+	else
 	{
 		UE_LOG(LogIsekaiAbilitySystem, Verbose,
 			TEXT("AbilityInputTagReleased: No abilities bound to input tag %s on %s"),
@@ -122,6 +243,8 @@ void UIsekaiAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag&
 
 void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGamePaused)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_ProcessAbilityInput);
+	
 	if (HasMatchingGameplayTag(Tags::State::AbilityInputBlocked))
 	{
 		ClearAbilityInput();
@@ -130,22 +253,24 @@ void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bG
 	
 	ABILITYLIST_SCOPE_LOCK();
 	
-	TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
+#if ISEKAI_INPUT_LATENCY_TRACE
+	for (const TPair<FGameplayAbilitySpecHandle, uint32>& PendingTrace : PendingInputTraces)
+	{
+		FIsekaiInputLatencyTracer::RecordStage(PendingTrace.Value, EIsekaiInputLatencyStage::Processed);
+	}
+#endif
+	
+	FInputSpecHandleArray AbilitiesToActivate;
+	EIsekaiAbilityActivationPolicy ActivationPolicy = EIsekaiAbilityActivationPolicy::OnSpawn;
 	
 	// 1. Handle held inputs
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputHeldSpecHandles)
 	{
-		if (FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(SpecHandle))
+		if (const FGameplayAbilitySpec* Spec = FindInputSpec(SpecHandle, ActivationPolicy))
 		{
-			const UIsekaiGameplayAbility* AbilityCDO =
-				Cast<UIsekaiGameplayAbility>(Spec->Ability);
-			
-			if (AbilityCDO && AbilityCDO->GetActivationPolicy() == EIsekaiAbilityActivationPolicy::WhileInputActive)
+			if (ActivationPolicy == EIsekaiAbilityActivationPolicy::WhileInputActive && !Spec->IsActive())
 			{
-				if (!Spec->IsActive())
-				{
-					AbilitiesToActivate.AddUnique(SpecHandle);
-				}
+				AbilitiesToActivate.AddUnique(SpecHandle);
 			}
 		}
 	}
@@ -153,7 +278,7 @@ void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bG
 	// 2. Handle newly pressed inputs
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputPressedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* Spec = FindInputSpec(SpecHandle, ActivationPolicy))
 		{
 			if (Spec->Ability)
 			{
@@ -162,17 +287,23 @@ void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bG
 				if (Spec->IsActive())
 				{
 					AbilitySpecInputPressed(*Spec);
-				}
-				else
-				{
-					const UIsekaiGameplayAbility* AbilityCDO =
-						Cast<UIsekaiGameplayAbility>(Spec->Ability);
 					
-					if (AbilityCDO && AbilityCDO->GetActivationPolicy() == EIsekaiAbilityActivationPolicy::OnInputTriggered)
+					// The running ability is not activated again, so keep the press until it ends (e.g. an attack mid-montage).
+					// Re-check, the forwarded press may have ended it already.
+					const FInputSpecCacheEntry* CacheEntry = InputSpecCache.Find(SpecHandle);
+					if (CacheEntry && CacheEntry->bBufferPressWhileActive && Spec->IsActive())
 					{
-						AbilitiesToActivate.AddUnique(SpecHandle);
+						uint32 TraceId = 0;
+#if ISEKAI_INPUT_LATENCY_TRACE
+						TraceId = ConsumeInputTrace(SpecHandle);
+#endif
+						BufferPressedSpec(SpecHandle, TraceId);
 					}
 				}
+				else if (ActivationPolicy == EIsekaiAbilityActivationPolicy::OnInputTriggered)
+				{
+					AbilitiesToActivate.AddUnique(SpecHandle);
+				}
 			}
 		}
 	}
@@ -180,13 +311,26 @@ void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bG
 	// 3. Activate Queued Abilities
 	for (const FGameplayAbilitySpecHandle& SpecHandle : AbilitiesToActivate)
 	{
-		TryActivateAbility(SpecHandle);
+		uint32 TraceId = 0;
+#if ISEKAI_INPUT_LATENCY_TRACE
+		TraceId = ConsumeInputTrace(SpecHandle);
+		const bool bActivated = TryActivateAbility(SpecHandle);
+		TraceActivation(TraceId, SpecHandle, bActivated);
+#else
+		const bool bActivated = TryActivateAbility(SpecHandle);
+#endif
+		
+		// A fresh press that was refused is kept for the buffer window instead of being dropped
+		if (!bActivated && InputPressedSpecHandles.Contains(SpecHandle))
+		{
+			BufferPressedSpec(SpecHandle, TraceId);
+		}
 	}
 	
 	// 4. Handle released inputs
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputReleasedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* Spec = FindInputSpec(SpecHandle, ActivationPolicy))
 		{
 			if (Spec->Ability)
 			{
@@ -204,19 +348,122 @@ void UIsekaiAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bG
 	// Clear pressed and released inputs
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
+	InputPressedTags.Reset();
+#if ISEKAI_INPUT_LATENCY_TRACE
+	PendingInputTraces.Reset();
+#endif
 }
 
 void UIsekaiAbilitySystemComponent::HandleOutOfHealth()
 {
-	UE_LOG(LogIsekaiAbilitySystem, Log,
+	UE_LOG(LogIsekaiAbilitySystem, Verbose,
 		TEXT("UIsekaiAbilitySystemComponent::HandleOutOfHealth on %s - clearing input and cancelling abilities."),
 		*GetName());
+	ISEKAI_TELEMETRY_EVENT(Death, GetAvatarActor());
 
 	ClearAbilityInput();
 	CancelAllAbilities();
 	
-	// Add the Death state tag
-	AddReplicatedLooseGameplayTag(Tags::State::Dead);
+	// Usually already set by the attribute set, the state is idempotent
+	if (IsOwnerActorAuthoritative())
+	{
+		SetCharacterState(EIsekaiCharacterState::Dead, true);
+	}
+}
+
+// --- Character States ---
+void UIsekaiAbilitySystemComponent::SetCharacterState(const EIsekaiCharacterState State, const bool bActive)
+{
+	if (!IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+	
+	const uint32 Bit = 1u << static_cast<uint32>(State);
+	const uint32 NewBits = bActive ? (CharacterStateBits | Bit) : (CharacterStateBits & ~Bit);
+	if (NewBits == CharacterStateBits)
+	{
+		return;
+	}
+	
+	CharacterStateBits = NewBits;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UIsekaiAbilitySystemComponent, CharacterStateBits, this);
+	ApplyCharacterStates();
+}
+
+void UIsekaiAbilitySystemComponent::ClearCharacterStates()
+{
+	if (!IsOwnerActorAuthoritative() || CharacterStateBits == 0)
+	{
+		return;
+	}
+	
+	CharacterStateBits = 0;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UIsekaiAbilitySystemComponent, CharacterStateBits, this);
+	ApplyCharacterStates();
+}
+
+void UIsekaiAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAbilitySystemComponent, CharacterStateBits, Params);
+}
+
+void UIsekaiAbilitySystemComponent::OnRep_CharacterStateBits()
+{
+	ApplyCharacterStates();
+}
+
+void UIsekaiAbilitySystemComponent::ApplyCharacterStates()
+{
+	const uint32 ChangedBits = CharacterStateBits ^ AppliedCharacterStateBits;
+	if (ChangedBits == 0)
+	{
+		return;
+	}
+	
+	// Mark as applied first, tag callbacks below may query the states
+	AppliedCharacterStateBits = CharacterStateBits;
+	
+	const bool bCanCancel = IsOwnerActorAuthoritative() || (AbilityActorInfo.IsValid() && AbilityActorInfo->IsLocallyControlled());
+	bool bAnyCleared = false;
+	
+	for (int32 StateIndex = 0; StateIndex < static_cast<int32>(EIsekaiCharacterState::MAX); ++StateIndex)
+	{
+		const uint32 Bit = 1u << StateIndex;
+		if ((ChangedBits & Bit) == 0)
+		{
+			continue;
+		}
+		
+		const FIsekaiCharacterStateRule& Rule = FIsekaiCharacterStateRule::Get(static_cast<EIsekaiCharacterState>(StateIndex));
+		if ((CharacterStateBits & Bit) != 0)
+		{
+			BlockAbilitiesWithTags(Rule.BlockedAbilityTags);
+			AddLooseGameplayTags(Rule.GrantedTags);
+			
+			// Same split as a cancel effect component: the server cancels, the owning client predicts it
+			if (bCanCancel && !Rule.CanceledAbilityTags.IsEmpty())
+			{
+				CancelActiveAbilitiesWithTags(Rule.CanceledAbilityTags);
+			}
+		}
+		else
+		{
+			UnBlockAbilitiesWithTags(Rule.BlockedAbilityTags);
+			RemoveLooseGameplayTags(Rule.GrantedTags);
+			bAnyCleared = true;
+		}
+	}
+	
+	// Ability blocks are not tag events, a buffered press blocked by the state is retried here
+	if (bAnyCleared)
+	{
+		RetryBufferedInput();
+	}
 }
 
 // --- Private API ---
@@ -225,4 +472,461 @@ void UIsekaiAbilitySystemComponent::ClearAbilityInput()
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
 	InputHeldSpecHandles.Reset();
+	InputPressedTags.Reset();
+	BufferedInputs.Reset();
+	UnwatchBlockingTags();
+#if ISEKAI_INPUT_LATENCY_TRACE
+	PendingInputTraces.Reset();
+#endif
+}
+
+void UIsekaiAbilitySystemComponent::BufferPressedSpec(const FGameplayAbilitySpecHandle& SpecHandle, const uint32 TraceId)
+{
+	// Pressed and released within the frame, there is nothing left to buffer
+	if (!InputHeldSpecHandles.Contains(SpecHandle))
+	{
+		return;
+	}
+	
+	for (const FGameplayTag& InputTag : InputPressedTags)
+	{
+		const auto* BoundHandles = InputTagToSpecHandles.Find(InputTag);
+		if (BoundHandles && BoundHandles->Contains(SpecHandle))
+		{
+			BufferInput(InputTag, TraceId);
+		}
+	}
+}
+
+void UIsekaiAbilitySystemComponent::BufferInput(const FGameplayTag& InputTag, const uint32 TraceId)
+{
+	if (InputBufferWindow <= 0.f)
+	{
+		return;
+	}
+	
+	const double ExpireTime = GetWorld()->GetTimeSeconds() + InputBufferWindow;
+	
+	// Latest press wins
+	if (FBufferedInput* Existing = BufferedInputs.FindByPredicate([&InputTag](const FBufferedInput& Buffered) { return Buffered.InputTag == InputTag; }))
+	{
+		Existing->ExpireTime = ExpireTime;
+		Existing->TraceId = TraceId;
+		return;
+	}
+	
+	BufferedInputs.Add({InputTag, ExpireTime, TraceId});
+	WatchBlockingTags(InputTag);
+}
+
+void UIsekaiAbilitySystemComponent::RemoveBufferedInput(const FGameplayTag& InputTag)
+{
+	const int32 Index = BufferedInputs.IndexOfByPredicate([&InputTag](const FBufferedInput& Buffered) { return Buffered.InputTag == InputTag; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+	
+	BufferedInputs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (BufferedInputs.IsEmpty())
+	{
+		UnwatchBlockingTags();
+	}
+}
+
+void UIsekaiAbilitySystemComponent::RetryBufferedInput()
+{
+	if (BufferedInputs.IsEmpty() || bRetryingBufferedInput)
+	{
+		return;
+	}
+	
+	// Still blocked, the entries simply run out
+	if (HasMatchingGameplayTag(Tags::State::AbilityInputBlocked))
+	{
+		return;
+	}
+	
+	TGuardValue<bool> RetryGuard(bRetryingBufferedInput, true);
+	const double Now = GetWorld()->GetTimeSeconds();
+	
+	for (int32 Index = BufferedInputs.Num() - 1; Index >= 0; --Index)
+	{
+		// An activation can clear the whole buffer (e.g. a death through HandleOutOfHealth), so copy and re-check
+		if (!BufferedInputs.IsValidIndex(Index))
+		{
+			continue;
+		}
+		
+		const FBufferedInput BufferedInput = BufferedInputs[Index];
+		if (Now > BufferedInput.ExpireTime || TryActivateBufferedInput(BufferedInput))
+		{
+			if (BufferedInputs.IsValidIndex(Index))
+			{
+				BufferedInputs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+		}
+	}
+	
+	if (BufferedInputs.IsEmpty())
+	{
+		UnwatchBlockingTags();
+	}
+}
+
+bool UIsekaiAbilitySystemComponent::TryActivateBufferedInput(const FBufferedInput& BufferedInput)
+{
+	const auto* BoundHandles = InputTagToSpecHandles.Find(BufferedInput.InputTag);
+	if (!BoundHandles)
+	{
+		// Everything bound to the input was removed, nothing left to retry
+		return true;
+	}
+	
+	// Activation can grant or remove abilities, which would invalidate the bound handle array
+	const FInputSpecHandleArray HandlesToTry(*BoundHandles);
+	EIsekaiAbilityActivationPolicy ActivationPolicy = EIsekaiAbilityActivationPolicy::OnSpawn;
+	bool bAnyActivated = false;
+	
+	for (const FGameplayAbilitySpecHandle& SpecHandle : HandlesToTry)
+	{
+		const FGameplayAbilitySpec* Spec = FindInputSpec(SpecHandle, ActivationPolicy);
+		if (!Spec || ActivationPolicy != EIsekaiAbilityActivationPolicy::OnInputTriggered || Spec->IsActive())
+		{
+			continue;
+		}
+		
+		const bool bActivated = TryActivateAbility(SpecHandle);
+#if ISEKAI_INPUT_LATENCY_TRACE
+		if (bActivated)
+		{
+			TraceActivation(BufferedInput.TraceId, SpecHandle, true);
+		}
+#endif
+		bAnyActivated |= bActivated;
+	}
+	
+	return bAnyActivated;
+}
+
+void UIsekaiAbilitySystemComponent::WatchBlockingTags(const FGameplayTag& InputTag)
+{
+	const auto* BoundHandles = InputTagToSpecHandles.Find(InputTag);
+	if (!BoundHandles)
+	{
+		return;
+	}
+	
+	FGameplayTagContainer BlockingTags;
+	for (const FGameplayAbilitySpecHandle& SpecHandle : *BoundHandles)
+	{
+		EIsekaiAbilityActivationPolicy ActivationPolicy;
+		const FGameplayAbilitySpec* Spec = FindInputSpec(SpecHandle, ActivationPolicy);
+		if (const UIsekaiGameplayAbility* AbilityCDO = Spec ? Cast<UIsekaiGameplayAbility>(Spec->Ability) : nullptr)
+		{
+			AbilityCDO->GetActivationBlockingTags(BlockingTags);
+		}
+	}
+	
+	for (const FGameplayTag& Tag : BlockingTags)
+	{
+		if (!BlockingTagEventHandles.Contains(Tag))
+		{
+			BlockingTagEventHandles.Add(Tag, RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::OnBlockingTagChanged));
+		}
+	}
+}
+
+void UIsekaiAbilitySystemComponent::UnwatchBlockingTags()
+{
+	for (const TPair<FGameplayTag, FDelegateHandle>& Pair : BlockingTagEventHandles)
+	{
+		RegisterGameplayTagEvent(Pair.Key, EGameplayTagEventType::NewOrRemoved).Remove(Pair.Value);
+	}
+	BlockingTagEventHandles.Reset();
+}
+
+void UIsekaiAbilitySystemComponent::OnAnyAbilityEnded(UGameplayAbility* Ability)
+{
+	RetryBufferedInput();
+}
+
+void UIsekaiAbilitySystemComponent::OnBlockingTagChanged(const FGameplayTag Tag, const int32 NewCount)
+{
+	// Only removals can unblock an activation
+	if (NewCount == 0)
+	{
+		RetryBufferedInput();
+	}
+}
+
+#if ISEKAI_INPUT_LATENCY_TRACE
+uint32 UIsekaiAbilitySystemComponent::ConsumeInputTrace(const FGameplayAbilitySpecHandle& SpecHandle)
+{
+	const int32 Index = PendingInputTraces.IndexOfByPredicate([&SpecHandle](const TPair<FGameplayAbilitySpecHandle, uint32>& PendingTrace)
+	{
+		return PendingTrace.Key == SpecHandle;
+	});
+	if (Index == INDEX_NONE)
+	{
+		return 0;
+	}
+	
+	const uint32 TraceId = PendingInputTraces[Index].Value;
+	PendingInputTraces.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	return TraceId;
+}
+
+void UIsekaiAbilitySystemComponent::TraceActivation(const uint32 TraceId, const FGameplayAbilitySpecHandle& SpecHandle, const bool bActivated)
+{
+	const FGameplayAbilitySpec* Spec = TraceId != 0 ? FindAbilitySpecFromHandle(SpecHandle) : nullptr;
+	if (!Spec || !Spec->Ability)
+	{
+		return;
+	}
+	
+	const FName AbilityName = Spec->Ability->GetClass()->GetFName();
+	if (!bActivated)
+	{
+		FIsekaiInputLatencyTracer::RecordStage(TraceId, EIsekaiInputLatencyStage::ActivationFailed, AbilityName);
+		return;
+	}
+	
+	// Instanced abilities keep the key they were activated with, non-instanced ones have already returned it
+	const UGameplayAbility* Instance = Spec->GetPrimaryInstance();
+	const FPredictionKey PredictionKey = Instance ? Instance->GetCurrentActivationInfo().GetActivationPredictionKey() : FPredictionKey();
+	FIsekaiInputLatencyTracer::TrackActivation(TraceId, AbilityName, PredictionKey);
+}
+#endif
+
+FGameplayAbilitySpec* UIsekaiAbilitySystemComponent::FindInputSpec(const FGameplayAbilitySpecHandle& SpecHandle, EIsekaiAbilityActivationPolicy& OutPolicy)
+{
+	if (bInputSpecIndicesDirty)
+	{
+		RebuildInputSpecIndices();
+	}
+	
+	const FInputSpecCacheEntry* CacheEntry = InputSpecCache.Find(SpecHandle);
+	if (!CacheEntry)
+	{
+		return nullptr;
+	}
+	
+	OutPolicy = CacheEntry->ActivationPolicy;
+	
+	if (ActivatableAbilities.Items.IsValidIndex(CacheEntry->SpecIndex) && ActivatableAbilities.Items[CacheEntry->SpecIndex].Handle == SpecHandle)
+	{
+		return &ActivatableAbilities.Items[CacheEntry->SpecIndex];
+	}
+	
+	// The list was reordered without a give/remove notification, resolve the slow way and rebuild next lookup
+	bInputSpecIndicesDirty = true;
+	return FindAbilitySpecFromHandle(SpecHandle);
+}
+
+void UIsekaiAbilitySystemComponent::RebuildInputSpecIndices()
+{
+	for (TPair<FGameplayAbilitySpecHandle, FInputSpecCacheEntry>& Pair : InputSpecCache)
+	{
+		Pair.Value.SpecIndex = INDEX_NONE;
+	}
+	
+	for (int32 Index = 0; Index < ActivatableAbilities.Items.Num(); ++Index)
+	{
+		if (FInputSpecCacheEntry* CacheEntry = InputSpecCache.Find(ActivatableAbilities.Items[Index].Handle))
+		{
+			CacheEntry->SpecIndex = Index;
+		}
+	}
+	
+	bInputSpecIndicesDirty = false;
 }
+
+void UIsekaiAbilitySystemComponent::AddToInputTagIndex(const FGameplayAbilitySpec& AbilitySpec)
+{
+	if (!AbilitySpec.Ability)
+	{
+		return;
+	}
+	
+	for (const FGameplayTag& Tag : AbilitySpec.GetDynamicSpecSourceTags())
+	{
+		InputTagToSpecHandles.FindOrAdd(Tag).AddUnique(AbilitySpec.Handle);
+	}
+}
+
+void UIsekaiAbilitySystemComponent::RemoveFromInputTagIndex(const FGameplayAbilitySpec& AbilitySpec)
+{
+	for (const FGameplayTag& Tag : AbilitySpec.GetDynamicSpecSourceTags())
+	{
+		if (auto* BoundHandles = InputTagToSpecHandles.Find(Tag))
+		{
+			BoundHandles->RemoveSwap(AbilitySpec.Handle, EAllowShrinking::No);
+			if (BoundHandles->IsEmpty())
+			{
+				InputTagToSpecHandles.Remove(Tag);
+			}
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+int32 UIsekaiAbilitySystemComponent::ResolveInputTagForBench(const FGameplayTag& InputTag) const
+{
+	FInputSpecHandleArray Matched;
+	if (const auto* BoundHandles = InputTagToSpecHandles.Find(InputTag))
+	{
+		for (const FGameplayAbilitySpecHandle& SpecHandle : *BoundHandles)
+		{
+			Matched.AddUnique(SpecHandle);
+		}
+	}
+	return Matched.Num();
+}
+
+int32 UIsekaiAbilitySystemComponent::ResolveHeldInputForBench(const TConstArrayView<FGameplayAbilitySpecHandle> HeldHandles)
+{
+	FInputSpecHandleArray AbilitiesToActivate;
+	EIsekaiAbilityActivationPolicy ActivationPolicy = EIsekaiAbilityActivationPolicy::OnSpawn;
+	for (const FGameplayAbilitySpecHandle& SpecHandle : HeldHandles)
+	{
+		if (FindInputSpec(SpecHandle, ActivationPolicy) && ActivationPolicy == EIsekaiAbilityActivationPolicy::WhileInputActive)
+		{
+			AbilitiesToActivate.AddUnique(SpecHandle);
+		}
+	}
+	return AbilitiesToActivate.Num() + HeldHandles.Num();
+}
+
+namespace
+{
+	/** The pre-index input event: scan every spec for the tag. Kept for the benchmark. */
+	int32 ScanInputTagLegacy(UAbilitySystemComponent* ASC, const FGameplayTag& InputTag)
+	{
+		TArray<FGameplayAbilitySpecHandle> Matched;
+		for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+		{
+			if (AbilitySpec.Ability && AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+			{
+				Matched.AddUnique(AbilitySpec.Handle);
+			}
+		}
+		return Matched.Num();
+	}
+	
+	/** The pre-cache per-frame resolve: linear search and CDO cast per handle, plus a heap activation list. */
+	int32 ResolveHeldInputLegacy(UAbilitySystemComponent* ASC, const TArray<FGameplayAbilitySpecHandle>& HeldHandles)
+	{
+		TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
+		for (const FGameplayAbilitySpecHandle& SpecHandle : HeldHandles)
+		{
+			if (const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(SpecHandle))
+			{
+				const UIsekaiGameplayAbility* AbilityCDO = Cast<UIsekaiGameplayAbility>(Spec->Ability);
+				if (AbilityCDO && AbilityCDO->GetActivationPolicy() == EIsekaiAbilityActivationPolicy::WhileInputActive)
+				{
+					AbilitiesToActivate.AddUnique(SpecHandle);
+				}
+			}
+		}
+		return AbilitiesToActivate.Num() + HeldHandles.Num();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchAbilityInput(
+	TEXT("Isekai.Ability.BenchInput"),
+	TEXT("Grants temporary abilities to the local player and times the input resolve of 60 Hz press/hold/release input, legacy scan against tag index and spec cache. Nothing is activated. Args: [NumAbilities=50] [Frames=600]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		UIsekaiAbilitySystemComponent* ASC = PC ? Cast<UIsekaiAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC->GetPawn())) : nullptr;
+		if (!ASC || !ASC->IsOwnerActorAuthoritative())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.Ability.BenchInput: Needs a locally controlled player with authority (standalone or listen server)"));
+			return;
+		}
+		
+		const int32 NumAbilities = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 600;
+		
+		// Input.Look is an axis handled by the controller, so no real ability listens to it.
+		// Every eighth bench ability is bound to it, the rest only pad the ability list like a loaded player.
+		const FGameplayTag BenchTag = Tags::Input::Look;
+		TArray<FGameplayAbilitySpecHandle> GrantedHandles;
+		TArray<FGameplayAbilitySpecHandle> BoundHandles;
+		for (int32 Index = 0; Index < NumAbilities; ++Index)
+		{
+			FGameplayAbilitySpec AbilitySpec(UIsekaiGameplayAbility::StaticClass(), 1, INDEX_NONE, ASC);
+			const bool bBound = Index % 8 == 0;
+			if (bBound)
+			{
+				AbilitySpec.GetDynamicSpecSourceTags().AddTag(BenchTag);
+			}
+			
+			const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(AbilitySpec);
+			GrantedHandles.Add(Handle);
+			if (bBound)
+			{
+				BoundHandles.Add(Handle);
+			}
+		}
+		
+		// Both sides do the same work per frame: a tag lookup on press and release, and the held-input resolve
+		int32 Checksum = 0;
+		TArray<FGameplayAbilitySpecHandle> LegacyHeld;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			// Press every half second, release a quarter second later, hold in between
+			const int32 Phase = Frame % 30;
+			if (Phase == 0)
+			{
+				LegacyHeld = BoundHandles;
+			}
+			else if (Phase == 15)
+			{
+				LegacyHeld.Reset();
+			}
+			
+			if (Phase == 0 || Phase == 15)
+			{
+				Checksum += ScanInputTagLegacy(ASC, BenchTag);
+			}
+			Checksum += ResolveHeldInputLegacy(ASC, LegacyHeld);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+		
+		TArray<FGameplayAbilitySpecHandle> CachedHeld;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const int32 Phase = Frame % 30;
+			if (Phase == 0)
+			{
+				CachedHeld = BoundHandles;
+			}
+			else if (Phase == 15)
+			{
+				CachedHeld.Reset();
+			}
+			
+			if (Phase == 0 || Phase == 15)
+			{
+				Checksum -= ASC->ResolveInputTagForBench(BenchTag);
+			}
+			Checksum -= ASC->ResolveHeldInputForBench(CachedHeld);
+		}
+		const double CachedSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		for (const FGameplayAbilitySpecHandle& Handle : GrantedHandles)
+		{
+			ASC->ClearAbility(Handle);
+		}
+		
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.Ability.BenchInput: %d abilities (%d bound), %d frames at 60 Hz"),
+			NumAbilities, BoundHandles.Num(), NumFrames);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Legacy scan and search: %.3f ms (%.2f us/frame)"), LegacySeconds * 1000.0, LegacySeconds * 1e6 / NumFrames);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Tag index and cache:    %.3f ms (%.2f us/frame)"), CachedSeconds * 1000.0, CachedSeconds * 1e6 / NumFrames);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Checksum %d (0 when both sides resolved the same handles)"), Checksum);
+	}));
+#endif
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "AIAssessment/AbilitySystem/IsekaiCharacterState.h"
+#include "AIAssessment/AbilitySystem/Ability/IsekaiGameplayAbility.h"
+#include "AIAssessment/Development/IsekaiInputLatencyTracer.h"
 #include "IsekaiAbilitySystemComponent.generated.h"
 
 /**
@@ -13,6 +16,8 @@
  * - Map input gameplay tags to ability specs and drive activation based on activation policy.
  * - Forward input pressed/released events to abilities for prediction-safe handling.
  * - Provide a central hook for shutting down all abilities when the owner runs out of health.
+ * - Index active abilities by asset tag, so tag-driven cancels only touch matching abilities.
+ * - Replicate binary character states (Dead, Exhausted) as a bitfield and apply their tags and blocks locally.
  */
 UCLASS(ClassGroup=(GAS), meta=(BlueprintSpawnableComponent))
 class AIASSESSMENT_API UIsekaiAbilitySystemComponent : public UAbilitySystemComponent
@@ -25,8 +30,9 @@ public:
 	/**
 	 * Registers that the given input tag was pressed this frame.
 	 * Called by the owning PlayerController from input bindings.
+	 * TraceId is an input latency trace carried to the activation of every ability bound to the tag, 0 for none.
 	 */
-	void AbilityInputTagPressed(const FGameplayTag& InputTag);
+	void AbilityInputTagPressed(const FGameplayTag& InputTag, uint32 TraceId = 0);
 
 	/**
 	 * Registers that the given input tag was released this frame.
@@ -45,25 +51,169 @@ public:
 	 * Clears all buffered input and cancels all active abilities on this ASC.
 	 */
 	void HandleOutOfHealth();
+	
+	/**
+	 * CancelAbilities(&WithTags) through the active ability tag index: only active abilities carrying one of the tags
+	 * (or a child of one) are visited, instead of every activatable ability.
+	 */
+	void CancelActiveAbilitiesWithTags(const FGameplayTagContainer& WithTags, UGameplayAbility* Ignore = nullptr);
+	
+	/** Routes ability-driven CancelAbilitiesWithTag through the active ability tag index. */
+	virtual void ApplyAbilityBlockAndCancelTags(const FGameplayTagContainer& AbilityTags, UGameplayAbility* RequestingAbility, bool bEnableBlockTags, const FGameplayTagContainer& BlockTags, bool bExecuteCancelTags, const FGameplayTagContainer& CancelTags) override;
+	
+	// --- Character States ---
+	/** Server-only: sets or clears a state. Only the bitfield replicates, every machine applies the state rule itself. */
+	void SetCharacterState(EIsekaiCharacterState State, bool bActive);
+	bool HasCharacterState(EIsekaiCharacterState State) const { return (CharacterStateBits & (1u << static_cast<uint32>(State))) != 0; }
+	
+	/** Server-only: clears every state, e.g. on respawn or when a pooled character is reused. */
+	void ClearCharacterStates();
+	
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	
+	/** Every effect applied to this ASC, including ones applied by other ASCs, passes through here. Instrumented only. */
+	virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+	
+#if !UE_BUILD_SHIPPING
+	// --- Isekai.Ability.BenchInput ---
+	/** The tag lookup of an input event, without touching the pending input arrays. Returns the bound handle count. */
+	int32 ResolveInputTagForBench(const FGameplayTag& InputTag) const;
+	/** The held-input resolve of ProcessAbilityInput, without activating anything. */
+	int32 ResolveHeldInputForBench(TConstArrayView<FGameplayAbilitySpecHandle> HeldHandles);
+#endif
 
 protected:
+	virtual void BeginPlay() override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
+	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled) override;
+	
 	/** Forwards input-pressed events to active abilities using generic replicated events. */
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	/** Forwards input-released events to active abilities using generic replicated events. */
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 	
-	/** Clears all internal input handle arrays (pressed/held/released). */
+	/** Clears all internal input handle arrays (pressed/held/released) and the input buffer. */
 	void ClearAbilityInput();
 	
+	/**
+	 * How long a held press that could not activate its ability is kept and retried, e.g. an attack pressed mid-montage.
+	 * Retries run when an ability ends or one of the abilities' blocking tags is removed, not every frame. 0 disables buffering.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="Isekai|Input", meta=(Unit="s", ClampMin="0.0"))
+	float InputBufferWindow = 0.2f;
+	
+	/** Only a handful of abilities are ever bound to one input, so these stay on the inline storage. */
+	using FInputSpecHandleArray = TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>>;
+	
 	/** Spec handles for abilities whose input tag was pressed this frame. */
-	UPROPERTY()
-	TArray<FGameplayAbilitySpecHandle> InputPressedSpecHandles;
+	FInputSpecHandleArray InputPressedSpecHandles;
 	
 	/** Spec handles for abilities whose input tag was released this frame. */
-	UPROPERTY()
-	TArray<FGameplayAbilitySpecHandle> InputReleasedSpecHandles;
+	FInputSpecHandleArray InputReleasedSpecHandles;
 	
 	/** Spec handles for abilities whose input is currently held down. */
-	UPROPERTY()
-	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
+	FInputSpecHandleArray InputHeldSpecHandles;
+	
+	/** Input tags pressed this frame, used to buffer presses whose abilities could not activate. */
+	TArray<FGameplayTag, TInlineAllocator<4>> InputPressedTags;
+	
+	UFUNCTION()
+	void OnRep_CharacterStateBits();
+	
+	/** One bit per EIsekaiCharacterState. */
+	UPROPERTY(ReplicatedUsing=OnRep_CharacterStateBits)
+	uint32 CharacterStateBits = 0;
+	
+#if ISEKAI_INPUT_LATENCY_TRACE
+	/** Latency traces of this frame's presses, consumed when the bound ability is activated. */
+	TArray<TPair<FGameplayAbilitySpecHandle, uint32>, TInlineAllocator<8>> PendingInputTraces;
+	
+	uint32 ConsumeInputTrace(const FGameplayAbilitySpecHandle& SpecHandle);
+	void TraceActivation(uint32 TraceId, const FGameplayAbilitySpecHandle& SpecHandle, bool bActivated);
+#endif
+
+private:
+	/** Applies or reverts the rules of every state whose bit differs from what was last applied on this machine. */
+	void ApplyCharacterStates();
+	
+	uint32 AppliedCharacterStateBits = 0;
+	
+	// --- Input Buffer ---
+	struct FBufferedInput
+	{
+		FGameplayTag InputTag;
+		double ExpireTime = 0.0;
+		/** Input latency trace of the original press, 0 when not traced. */
+		uint32 TraceId = 0;
+	};
+	
+	/** Buffers this frame's press of every input tag bound to SpecHandle, as long as the input is still held. */
+	void BufferPressedSpec(const FGameplayAbilitySpecHandle& SpecHandle, uint32 TraceId);
+	
+	/** Keeps the latest refused press of InputTag until the buffer window runs out or the input is released. */
+	void BufferInput(const FGameplayTag& InputTag, uint32 TraceId);
+	void RemoveBufferedInput(const FGameplayTag& InputTag);
+	
+	/** Retries every live buffered press, dropping the ones that activated or expired. */
+	void RetryBufferedInput();
+	bool TryActivateBufferedInput(const FBufferedInput& BufferedInput);
+	
+	/** Listens for the removal of the tags that can block the abilities bound to InputTag. */
+	void WatchBlockingTags(const FGameplayTag& InputTag);
+	/** Stops listening once nothing is buffered anymore. */
+	void UnwatchBlockingTags();
+	
+	void OnAnyAbilityEnded(UGameplayAbility* Ability);
+	void OnBlockingTagChanged(FGameplayTag Tag, int32 NewCount);
+	
+	/** One entry per input tag, only a few inputs can be pending at once. */
+	TArray<FBufferedInput, TInlineAllocator<4>> BufferedInputs;
+	
+	/** Blocking tag -> removal listener, only registered while something is buffered. */
+	TMap<FGameplayTag, FDelegateHandle> BlockingTagEventHandles;
+	
+	/** Activating a buffered ability can end or untag others, which must not retry recursively. */
+	bool bRetryingBufferedInput = false;
+	
+	/**
+	 * Resolves a spec handle through the input spec cache and returns the activation policy captured at grant time.
+	 * Falls back to the linear search, and schedules a rebuild, if the cached index went stale.
+	 */
+	FGameplayAbilitySpec* FindInputSpec(const FGameplayAbilitySpecHandle& SpecHandle, EIsekaiAbilityActivationPolicy& OutPolicy);
+	void RebuildInputSpecIndices();
+	
+	/** Indexes the spec under each of its dynamic source tags. */
+	void AddToInputTagIndex(const FGameplayAbilitySpec& AbilitySpec);
+	void RemoveFromInputTagIndex(const FGameplayAbilitySpec& AbilitySpec);
+	
+	/**
+	 * Input tag -> spec handles bound to it, kept in sync on give/remove (including replicated specs on clients)
+	 * so input events cost the abilities bound to the tag instead of every granted ability.
+	 */
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>> InputTagToSpecHandles;
+	
+	struct FInputSpecCacheEntry
+	{
+		/** Index into ActivatableAbilities.Items, only valid while bInputSpecIndicesDirty is false. */
+		int32 SpecIndex = INDEX_NONE;
+		/** Abilities that are not UIsekaiGameplayAbility are stored as OnSpawn, i.e. never activated by input. */
+		EIsekaiAbilityActivationPolicy ActivationPolicy = EIsekaiAbilityActivationPolicy::OnSpawn;
+		/** Whether a press while the ability runs is buffered until it ends, see UIsekaiGameplayAbility::ShouldBufferPressWhileActive. */
+		bool bBufferPressWhileActive = false;
+	};
+	
+	/** Spec handle -> spec index and activation policy, so input processing never searches the list or casts the CDO. */
+	TMap<FGameplayAbilitySpecHandle, FInputSpecCacheEntry> InputSpecCache;
+	
+	/** Set whenever the ability list changes, indices are rebuilt lazily on the next lookup. */
+	bool bInputSpecIndicesDirty = true;
+	
+	// --- Active Ability Tag Index ---
+	/**
+	 * Asset tag (and each of its parents, so parent queries match like HasAny) -> handles of active abilities.
+	 * A handle is listed once per running activation, added on activate and removed on end.
+	 */
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>> ActiveAbilityTagIndex;
 };
@@ -9,8 +9,10 @@
 #include "AIAssessment/NativeGameplayTags.h"
 #include "AIAssessment/Character/IsekaiCharacterBase.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
-#include "Effect/GameplayEffect_State_Dead.h"
-#include "Effect/GameplayEffect_State_Exhausted.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "AbilitySystemGlobals.h"
+#include "GameFramework/PlayerController.h"
 
 UIsekaiAttributeSet::UIsekaiAttributeSet()
 {
@@ -20,14 +22,34 @@ void UIsekaiAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, Health,				COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, MaxHealth,			COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, Stamina,			COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, MaxStamina,			COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, HealthRegenRate,	COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, HealthRegenDelay,	COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, StaminaRegenRate,	COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UIsekaiAttributeSet, StaminaRegenDelay,	COND_None, REPNOTIFY_Always);
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+	SharedParams.RepNotifyCondition = REPNOTIFY_Always;
+	
+	FDoRepLifetimeParams OwnerOnlyParams = SharedParams;
+	OwnerOnlyParams.Condition = COND_OwnerOnly;
+	
+	FDoRepLifetimeParams SkipOwnerParams = SharedParams;
+	SkipOwnerParams.Condition = COND_SkipOwner;
+	SkipOwnerParams.RepNotifyCondition = REPNOTIFY_OnChanged;
+	
+	FDoRepLifetimeParams OwnerTrajectoryParams = OwnerOnlyParams;
+	OwnerTrajectoryParams.RepNotifyCondition = REPNOTIFY_OnChanged;
+	
+	// Only the owner gets full-precision Health, proxies read the quantized ProxyHealth (COND_SkipOwner) for overhead widgets.
+	// MaxHealth goes to everyone
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, Health,				OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, ProxyHealth,		SkipOwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, MaxHealth,			SharedParams);
+	
+	// Only the owner's HUD and prediction read these
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, Stamina,			OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, MaxStamina,			OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, HealthRegenRate,	OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, HealthRegenDelay,	OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, StaminaRegenRate,	OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, StaminaRegenDelay,	OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UIsekaiAttributeSet, StaminaTrajectory,	OwnerTrajectoryParams);
 }
 
 void UIsekaiAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
@@ -35,106 +57,172 @@ void UIsekaiAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute
 	Super::PreAttributeChange(Attribute, NewValue);
 	
 	// Clamping
-	if (Attribute == GetHealthAttribute())
-	{
-		NewValue = FMath::Clamp(NewValue, 0.0f, GetMaxHealth());
-	}
-	else if (Attribute == GetStaminaAttribute())
-	{
-		NewValue = FMath::Clamp(NewValue, 0.0f, GetMaxStamina());
-	}
-	// Keep Above Zero
-	else if (Attribute == GetMaxHealthAttribute())
-	{
-		NewValue = FMath::Max(1.0f, NewValue);
-	}
-	else if (Attribute == GetMaxStaminaAttribute())
-	{
-		NewValue = FMath::Max(0.0f, NewValue);
-	}
-	else if (Attribute == GetStaminaRegenRateAttribute())
+	if (const FAttributeRule* Rule = FindAttributeRule(Attribute))
 	{
-		NewValue = FMath::Max(0.0f, NewValue);
+		NewValue = FMath::Max(Rule->MinValue, NewValue);
+		if (Rule->MaxAttribute)
+		{
+			NewValue = FMath::Min(NewValue, (this->*Rule->MaxAttribute).GetCurrentValue());
+		}
 	}
-	else if (Attribute == GetStaminaRegenDelayAttribute())
+}
+
+void UIsekaiAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+	
+	MarkAttributeDirty(Attribute);
+	
+	if (Attribute == GetHealthAttribute())
 	{
-		NewValue = FMath::Max(0.0f, NewValue);
+		UpdateProxyHealth(NewValue);
 	}
 }
 
+void UIsekaiAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+	
+	// The base value replicates too, even when a modifier keeps the current value unchanged
+	MarkAttributeDirty(Attribute);
+}
+
 void UIsekaiAttributeSet::PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data)
 {
 	Super::PostGameplayEffectExecute(Data);
 	
-	AActor* TargetActor = nullptr;
-	UIsekaiAbilitySystemComponent* TargetIsekaiASC = nullptr;
+	const FAttributeRule* Rule = FindAttributeRule(Data.EvaluatedData.Attribute);
+	if (!Rule || !Rule->PostExecute)
+	{
+		return;
+	}
 	
+	FPostExecuteContext Context;
 	if (Data.Target.AbilityActorInfo.IsValid())
 	{
-		TargetActor = Data.Target.AbilityActorInfo->AvatarActor.Get();
-		TargetIsekaiASC = Cast<UIsekaiAbilitySystemComponent>(Data.Target.AbilityActorInfo->AbilitySystemComponent.Get());
+		Context.TargetASC = Cast<UIsekaiAbilitySystemComponent>(Data.Target.AbilityActorInfo->AbilitySystemComponent.Get());
+		Context.TargetCharacter = Cast<AIsekaiCharacterBase>(Data.Target.AbilityActorInfo->AvatarActor.Get());
 	}
 	
-	AIsekaiCharacterBase* TargetCharacter = Cast<AIsekaiCharacterBase>(TargetActor); 
+	(this->*Rule->PostExecute)(Context);
+}
+
+
+// --- Attribute Rules ---
+const UIsekaiAttributeSet::FAttributeRule* UIsekaiAttributeSet::FindAttributeRule(const FGameplayAttribute& Attribute)
+{
+	// Giving an attribute clamping or a post-execute handler only takes a row here
+	static constexpr FAttributeRule Rules[] =
+	{
+		{ &ThisClass::Health,				0.f,	&ThisClass::MaxHealth,	&ThisClass::PostExecuteHealth },
+		{ &ThisClass::MaxHealth,			1.f,	nullptr,				&ThisClass::PostExecuteMaxHealth },
+		{ &ThisClass::Stamina,				0.f,	&ThisClass::MaxStamina,	&ThisClass::PostExecuteStamina },
+		{ &ThisClass::MaxStamina,			0.f,	nullptr,				&ThisClass::PostExecuteMaxStamina },
+		{ &ThisClass::StaminaRegenRate,		0.f,	nullptr,				nullptr },
+		{ &ThisClass::StaminaRegenDelay,	0.f,	nullptr,				nullptr },
+	};
+	static_assert(UE_ARRAY_COUNT(Rules) < MAX_int8, "Rule indices are stored as int8");
 	
-	const FGameplayAttribute& Attribute = Data.EvaluatedData.Attribute;
+	constexpr int32 OffsetStep = alignof(FGameplayAttributeData);
 	
-	// Health
-	if (Attribute == GetHealthAttribute())
+	// Rule index per aligned property offset, built once from the CDO's layout
+	struct FOffsetTable
 	{
-		const float NewHealth = FMath::Clamp(GetHealth(), 0.0f, GetMaxHealth());
-		SetHealth(NewHealth);
+		int32 BaseOffset = MAX_int32;
+		TArray<int8> RuleIndices;
+	};
+	static const FOffsetTable Table = []()
+	{
+		const UIsekaiAttributeSet* CDO = GetDefault<UIsekaiAttributeSet>();
+		const auto OffsetOf = [CDO](FGameplayAttributeData UIsekaiAttributeSet::* Member)
+		{
+			return static_cast<int32>(reinterpret_cast<const uint8*>(&(CDO->*Member)) - reinterpret_cast<const uint8*>(CDO));
+		};
 		
-		if (NewHealth <= 0.0f)
+		FOffsetTable Result;
+		int32 MaxOffset = 0;
+		for (const FAttributeRule& Rule : Rules)
 		{
-			HandleOutOfHealth(TargetIsekaiASC);
-			
-			if (TargetCharacter)
-			{
-				TargetCharacter->HandleOutOfHealth();
-			}
+			Result.BaseOffset = FMath::Min(Result.BaseOffset, OffsetOf(Rule.Attribute));
+			MaxOffset = FMath::Max(MaxOffset, OffsetOf(Rule.Attribute));
 		}
-	}
-	
-	// Max Health
-	else if (Attribute == GetMaxHealthAttribute())
-	{
-		const float NewMaxHealth = FMath::Max(1.0f, GetMaxHealth());
-		SetMaxHealth(NewMaxHealth);
 		
-		// Adjust current Health to not exceed new MaxHealth
-		if (GetHealth() > NewMaxHealth)
+		Result.RuleIndices.Init(INDEX_NONE, (MaxOffset - Result.BaseOffset) / OffsetStep + 1);
+		for (int32 RuleIndex = 0; RuleIndex < UE_ARRAY_COUNT(Rules); ++RuleIndex)
 		{
-			SetHealth(NewMaxHealth);
+			Result.RuleIndices[(OffsetOf(Rules[RuleIndex].Attribute) - Result.BaseOffset) / OffsetStep] = static_cast<int8>(RuleIndex);
 		}
+		return Result;
+	}();
+	
+	const FProperty* Property = Attribute.GetUProperty();
+	if (!Property || Attribute.GetAttributeSetClass() != StaticClass())
+	{
+		return nullptr;
 	}
 	
-	// Stamina
-	else if (Attribute == GetStaminaAttribute())
+	const int32 RelativeOffset = Property->GetOffset_ForInternal() - Table.BaseOffset;
+	if (RelativeOffset < 0 || RelativeOffset % OffsetStep != 0)
 	{
-		const float NewStamina = FMath::Clamp(GetStamina(), 0.0f, GetMaxStamina());
-		SetStamina(NewStamina);
-		
-		 if (TargetIsekaiASC)
-		 {
-		 	HandleExhaustionStateChange(TargetIsekaiASC, NewStamina);
-		 }
+		return nullptr;
 	}
 	
-	// Max Stamina
-	else if (Attribute == GetMaxStaminaAttribute())
+	const int32 Slot = RelativeOffset / OffsetStep;
+	const int8 RuleIndex = Table.RuleIndices.IsValidIndex(Slot) ? Table.RuleIndices[Slot] : INDEX_NONE;
+	return RuleIndex != INDEX_NONE ? &Rules[RuleIndex] : nullptr;
+}
+
+void UIsekaiAttributeSet::PostExecuteHealth(const FPostExecuteContext& Context)
+{
+	const float NewHealth = FMath::Clamp(GetHealth(), 0.0f, GetMaxHealth());
+	SetHealth(NewHealth);
+	
+	if (NewHealth <= 0.0f)
 	{
-		const float NewMaxStamina = FMath::Max(0.0f, GetMaxStamina());
-		SetMaxStamina(NewMaxStamina);
+		HandleOutOfHealth(Context.TargetASC);
 		
-		// Adjust current Stamina to not exceed new MaxStamina
-		if (GetStamina() > NewMaxStamina)
+		if (Context.TargetCharacter)
 		{
-			SetStamina(NewMaxStamina);
+			Context.TargetCharacter->HandleOutOfHealth();
 		}
 	}
 }
 
+void UIsekaiAttributeSet::PostExecuteMaxHealth(const FPostExecuteContext& Context)
+{
+	const float NewMaxHealth = FMath::Max(1.0f, GetMaxHealth());
+	SetMaxHealth(NewMaxHealth);
+	
+	// Adjust current Health to not exceed new MaxHealth
+	if (GetHealth() > NewMaxHealth)
+	{
+		SetHealth(NewMaxHealth);
+	}
+}
+
+void UIsekaiAttributeSet::PostExecuteStamina(const FPostExecuteContext& Context)
+{
+	const float NewStamina = FMath::Clamp(GetStamina(), 0.0f, GetMaxStamina());
+	SetStamina(NewStamina);
+	
+	if (Context.TargetASC)
+	{
+		HandleExhaustionStateChange(Context.TargetASC, NewStamina);
+	}
+}
+
+void UIsekaiAttributeSet::PostExecuteMaxStamina(const FPostExecuteContext& Context)
+{
+	const float NewMaxStamina = FMath::Max(0.0f, GetMaxStamina());
+	SetMaxStamina(NewMaxStamina);
+	
+	// Adjust current Stamina to not exceed new MaxStamina
+	if (GetStamina() > NewMaxStamina)
+	{
+		SetStamina(NewMaxStamina);
+	}
+}
+
 
 // --- Custom Handlers ---
 void UIsekaiAttributeSet::HandleExhaustionStateChange(UIsekaiAbilitySystemComponent* TargetIsekaiASC, const float NewStamina)
@@ -144,39 +232,27 @@ void UIsekaiAttributeSet::HandleExhaustionStateChange(UIsekaiAbilitySystemCompon
 		return;
 	}
 	
-	const bool bHasExhausted = TargetIsekaiASC->HasMatchingGameplayTag(Tags::State::Exhausted);
+	const bool bHasExhausted = TargetIsekaiASC->HasCharacterState(EIsekaiCharacterState::Exhausted);
 		 	
-	// Hit zero stamina -> apply exhausted state
+	// Hit zero stamina -> enter exhausted state
 	if (NewStamina <= 0.0f && !bHasExhausted)
 	{
 		UE_LOG(LogIsekaiAbilitySystem, Log,
-			TEXT("Applying Exhausted state: ASC=%s Stamina=%.2f"),
+			TEXT("Entering Exhausted state: ASC=%s Stamina=%.2f"),
 			*TargetIsekaiASC->GetName(),
 			NewStamina);
 
-		FGameplayEffectContextHandle Ctx = TargetIsekaiASC->MakeEffectContext();
-		Ctx.AddSourceObject(this);
-		 	
-		// create gamplay effect spec from the state effect class which is set to be infinite duration
-		const FGameplayEffectSpecHandle SpecHandle =
-			TargetIsekaiASC->MakeOutgoingSpec(UGameplayEffect_State_Exhausted::StaticClass(), 1.0f, Ctx);
-		 	
-		if (SpecHandle.IsValid())
-		{
-			ExhaustedStateEffectHandle = 
-				TargetIsekaiASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-		}
+		TargetIsekaiASC->SetCharacterState(EIsekaiCharacterState::Exhausted, true);
 	}
-	// Recovered stamina -> remove exhausted state
-	else if (NewStamina >= GetMaxStamina() && bHasExhausted && ExhaustedStateEffectHandle.IsValid())
+	// Recovered stamina -> leave exhausted state
+	else if (NewStamina >= GetMaxStamina() && bHasExhausted)
 	{
 		UE_LOG(LogIsekaiAbilitySystem, Log,
-			TEXT("Removing Exhausted state: ASC=%s Stamina=%.2f"),
+			TEXT("Leaving Exhausted state: ASC=%s Stamina=%.2f"),
 			*TargetIsekaiASC->GetName(),
 			NewStamina);
 
-		TargetIsekaiASC->RemoveActiveGameplayEffect(ExhaustedStateEffectHandle);
-		ExhaustedStateEffectHandle.Invalidate();
+		TargetIsekaiASC->SetCharacterState(EIsekaiCharacterState::Exhausted, false);
 	}
 }
 
@@ -187,9 +263,7 @@ void UIsekaiAttributeSet::HandleOutOfHealth(UIsekaiAbilitySystemComponent* Targe
 		return;
 	}
 	
-	const bool bIsAlreadyDead = TargetIsekaiASC->HasMatchingGameplayTag(Tags::State::Dead) || DeadStateEffectHandle.IsValid();
-	
-	if (bIsAlreadyDead)
+	if (TargetIsekaiASC->HasCharacterState(EIsekaiCharacterState::Dead))
 	{
 		UE_LOG(LogIsekaiAbilitySystem, Verbose,
 			TEXT("HandleOutOfHealth called but ASC %s is already dead."),
@@ -198,26 +272,66 @@ void UIsekaiAttributeSet::HandleOutOfHealth(UIsekaiAbilitySystemComponent* Targe
 	}
 	
 	UE_LOG(LogIsekaiAbilitySystem, Log,
-		TEXT("Applying Dead state GE for ASC %s"),
+		TEXT("Entering Dead state for ASC %s"),
 		*TargetIsekaiASC->GetName());
 
-	FGameplayEffectContextHandle Ctx = TargetIsekaiASC->MakeEffectContext();
-	Ctx.AddSourceObject(this);
-	
-	const FGameplayEffectSpecHandle SpecHandle =
-		TargetIsekaiASC->MakeOutgoingSpec(UGameplayEffect_State_Dead::StaticClass(), 1.0f, Ctx);
+	TargetIsekaiASC->SetCharacterState(EIsekaiCharacterState::Dead, true);
+}
+
+void UIsekaiAttributeSet::HandleIntegratedStaminaChange(UIsekaiAbilitySystemComponent* TargetASC)
+{
+	HandleExhaustionStateChange(TargetASC, GetStamina());
+}
+
+// --- Replication ---
+void UIsekaiAttributeSet::MarkAttributeDirty(const FGameplayAttribute& Attribute) const
+{
+	if (const FProperty* Property = Attribute.GetUProperty())
+	{
+		MARK_PROPERTY_DIRTY(this, Property);
+	}
+}
+
+void UIsekaiAttributeSet::UpdateProxyHealth(const float NewHealth)
+{
+	const AActor* OwningActor = GetOwningActor();
+	if (!OwningActor || !OwningActor->HasAuthority())
+	{
+		return;
+	}
 	
-	if (SpecHandle.IsValid())
+	// Rounded up, so a sliver of health never shows as dead
+	const uint16 NewProxyHealth = static_cast<uint16>(FMath::Clamp(FMath::CeilToInt32(NewHealth), 0, static_cast<int32>(MAX_uint16)));
+	if (NewProxyHealth != ProxyHealth)
 	{
-		DeadStateEffectHandle = 
-			TargetIsekaiASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+		ProxyHealth = NewProxyHealth;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UIsekaiAttributeSet, ProxyHealth, this);
 	}
 }
 
-void UIsekaiAttributeSet::InvalidateTransientEffectHandles()
+// --- Stamina Trajectory ---
+void UIsekaiAttributeSet::SetStaminaTrajectory(const FIsekaiStaminaTrajectory& NewTrajectory)
+{
+	StaminaTrajectory = NewTrajectory;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UIsekaiAttributeSet, StaminaTrajectory, this);
+	OnStaminaTrajectoryChanged.Broadcast();
+}
+
+float UIsekaiAttributeSet::GetCurrentStamina() const
 {
-	DeadStateEffectHandle.Invalidate();
-	ExhaustedStateEffectHandle.Invalidate();
+	return StaminaTrajectory.IsValid() ? StaminaTrajectory.Evaluate(GetServerTime()) : GetStamina();
+}
+
+float UIsekaiAttributeSet::GetServerTime() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return 0.f;
+	}
+	
+	const AGameStateBase* GameState = World->GetGameState();
+	return static_cast<float>(GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds());
 }
 
 // --- Replication Notification ---
@@ -260,3 +374,118 @@ void UIsekaiAttributeSet::OnRep_StaminaRegenDelay(const FGameplayAttributeData&
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UIsekaiAttributeSet, StaminaRegenDelay, OldValue);
 }
+
+void UIsekaiAttributeSet::OnRep_StaminaTrajectory()
+{
+	OnStaminaTrajectoryChanged.Broadcast();
+}
+
+void UIsekaiAttributeSet::OnRep_ProxyHealth()
+{
+	// Non-owners never receive Health itself, feed the rounded value through the ASC so change delegates fire
+	if (UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent())
+	{
+		ASC->SetNumericAttributeBase(GetHealthAttribute(), ProxyHealth);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	/** The pre-table clamp: an if-else chain of attribute comparisons. Kept for the benchmark. */
+	void ClampAttributeLegacy(const UIsekaiAttributeSet* AttributeSet, const FGameplayAttribute& Attribute, float& NewValue)
+	{
+		if (Attribute == UIsekaiAttributeSet::GetHealthAttribute())
+		{
+			NewValue = FMath::Clamp(NewValue, 0.0f, AttributeSet->GetMaxHealth());
+		}
+		else if (Attribute == UIsekaiAttributeSet::GetStaminaAttribute())
+		{
+			NewValue = FMath::Clamp(NewValue, 0.0f, AttributeSet->GetMaxStamina());
+		}
+		else if (Attribute == UIsekaiAttributeSet::GetMaxHealthAttribute())
+		{
+			NewValue = FMath::Max(1.0f, NewValue);
+		}
+		else if (Attribute == UIsekaiAttributeSet::GetMaxStaminaAttribute())
+		{
+			NewValue = FMath::Max(0.0f, NewValue);
+		}
+		else if (Attribute == UIsekaiAttributeSet::GetStaminaRegenRateAttribute())
+		{
+			NewValue = FMath::Max(0.0f, NewValue);
+		}
+		else if (Attribute == UIsekaiAttributeSet::GetStaminaRegenDelayAttribute())
+		{
+			NewValue = FMath::Max(0.0f, NewValue);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchAttributeExecute(
+	TEXT("Isekai.Attributes.BenchExecute"),
+	TEXT("Times the attribute clamp dispatch (legacy if-else chain vs. offset table) over every attribute, then applies a value-neutral instant stamina GE to the local player's ASC. Args: [Executions=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		UIsekaiAbilitySystemComponent* ASC = PC ? Cast<UIsekaiAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC->GetPawn())) : nullptr;
+		UIsekaiAttributeSet* AttributeSet = ASC ? const_cast<UIsekaiAttributeSet*>(ASC->GetSet<UIsekaiAttributeSet>()) : nullptr;
+		if (!AttributeSet || !ASC->IsOwnerActorAuthoritative())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.Attributes.BenchExecute: Needs a locally controlled player with authority (standalone or listen server)"));
+			return;
+		}
+		
+		const int32 NumExecutions = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		
+		const FGameplayAttribute Attributes[] =
+		{
+			UIsekaiAttributeSet::GetHealthAttribute(), UIsekaiAttributeSet::GetMaxHealthAttribute(),
+			UIsekaiAttributeSet::GetStaminaAttribute(), UIsekaiAttributeSet::GetMaxStaminaAttribute(),
+			UIsekaiAttributeSet::GetHealthRegenRateAttribute(), UIsekaiAttributeSet::GetHealthRegenDelayAttribute(),
+			UIsekaiAttributeSet::GetStaminaRegenRateAttribute(), UIsekaiAttributeSet::GetStaminaRegenDelayAttribute(),
+		};
+		constexpr int32 NumAttributes = UE_ARRAY_COUNT(Attributes);
+		
+		float Checksum = 0.f;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumExecutions; ++Index)
+		{
+			float Value = static_cast<float>(Index % 200) - 50.f;
+			ClampAttributeLegacy(AttributeSet, Attributes[Index % NumAttributes], Value);
+			Checksum += Value;
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+		
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumExecutions; ++Index)
+		{
+			float Value = static_cast<float>(Index % 200) - 50.f;
+			AttributeSet->PreAttributeChange(Attributes[Index % NumAttributes], Value);
+			Checksum -= Value;
+		}
+		const double TableSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		// Same path as a drain tick: Pre/PostGameplayEffectExecute, PreAttributeChange and the Stamina handler
+		UGameplayEffect* BenchEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_BenchStaminaTick"));
+		BenchEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+		FGameplayModifierInfo& Modifier = BenchEffect->Modifiers.AddDefaulted_GetRef();
+		Modifier.Attribute = UIsekaiAttributeSet::GetStaminaAttribute();
+		Modifier.ModifierOp = EGameplayModOp::Additive;
+		Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(0.f));
+		
+		const FGameplayEffectContextHandle Context = ASC->MakeEffectContext();
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumExecutions; ++Index)
+		{
+			ASC->ApplyGameplayEffectToSelf(BenchEffect, 1.f, Context);
+		}
+		const double ExecuteSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.Attributes.BenchExecute: %d executions over %d attributes"), NumExecutions, NumAttributes);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Legacy clamp chain:  %.3f ms (%.1f ns/call)"), LegacySeconds * 1000.0, LegacySeconds * 1e9 / NumExecutions);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Offset table clamp:  %.3f ms (%.1f ns/call)"), TableSeconds * 1000.0, TableSeconds * 1e9 / NumExecutions);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Instant stamina GE:  %.3f ms (%.0f executions/s)"), ExecuteSeconds * 1000.0, NumExecutions / FMath::Max(ExecuteSeconds, UE_SMALL_NUMBER));
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Checksum %.1f"), Checksum);
+	}));
+#endif
@@ -13,12 +13,76 @@
 	GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 	GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+class AIsekaiCharacterBase;
 class UIsekaiAbilitySystemComponent;
+
+/**
+ * Analytic stamina curve, replicated instead of every integrated stamina value.
+ * Value is exact at ServerTime. Drain applies from then on, regen only once RegenResumeTime has passed.
+ * The server republishes it whenever a rate changes and on a slow correction interval, clients evaluate it against
+ * the replicated server clock.
+ */
+USTRUCT()
+struct FIsekaiStaminaTrajectory
+{
+	GENERATED_BODY()
+	
+	UPROPERTY()
+	float ServerTime = 0.f;
+	
+	UPROPERTY()
+	float RegenResumeTime = 0.f;
+	
+	UPROPERTY()
+	float Value = 0.f;
+	
+	UPROPERTY()
+	float Max = 0.f;
+	
+	/** Already zero while regen is blocked by tags. */
+	UPROPERTY()
+	float RegenRate = 0.f;
+	
+	UPROPERTY()
+	float DrainRate = 0.f;
+	
+	bool IsValid() const { return ServerTime > 0.f; }
+	
+	/** True while evaluating at a later time can still return a different value. */
+	bool IsChanging(const float AtServerTime) const
+	{
+		const float Rate = (AtServerTime < RegenResumeTime ? 0.f : RegenRate) - DrainRate;
+		return (Rate < 0.f && Evaluate(AtServerTime) > 0.f) || (RegenRate > DrainRate && Evaluate(AtServerTime) < Max);
+	}
+	
+	float Evaluate(const float AtServerTime) const
+	{
+		if (AtServerTime <= ServerTime)
+		{
+			return Value;
+		}
+		
+		// Drain only until regen resumes, then the net rate
+		const float DelayEnd = FMath::Min(AtServerTime, FMath::Max(ServerTime, RegenResumeTime));
+		float Result = FMath::Clamp(Value - DrainRate * (DelayEnd - ServerTime), 0.f, Max);
+		if (AtServerTime > DelayEnd)
+		{
+			Result = FMath::Clamp(Result + (RegenRate - DrainRate) * (AtServerTime - DelayEnd), 0.f, Max);
+		}
+		return Result;
+	}
+};
+
 /**
  * Core shared attributes for player- and AI-controlled characters.
  *
- * Owns health, stamina and their regen parameters, and drives stateful gameplay effects
- * such as Dead and Exhausted when thresholds are reached on the server.
+ * Owns health, stamina and their regen parameters, and drives the Dead and Exhausted character states
+ * on the ASC when thresholds are reached on the server.
+ *
+ * REPLICATION:
+ * All properties are push-model. Stamina, its trajectory and the regen parameters only go to the owner.
+ * Health goes to the owner at full precision, everyone else gets ProxyHealth, rounded up to whole points,
+ * which is enough for overhead widgets and only changes when a whole point is crossed.
  */
 UCLASS()
 class AIASSESSMENT_API UIsekaiAttributeSet : public UAttributeSet
@@ -31,12 +95,24 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
 	
-	/**
-	 * Clears transient gameplay effect handles (Dead / Exhausted) used across respawns.
-	 * Does not modify attributes or remove active effects; see PlayerState for full respawn logic.
-	 */
-	void InvalidateTransientEffectHandles();
+	/** Server-only: re-checks the exhaustion thresholds after stamina was written directly, e.g. by the regen subsystem. */
+	void HandleIntegratedStaminaChange(UIsekaiAbilitySystemComponent* TargetASC);
+	
+	// --- Stamina Trajectory ---
+	/** Server-only: publishes a new stamina curve. Fires OnStaminaTrajectoryChanged locally and on clients. */
+	void SetStaminaTrajectory(const FIsekaiStaminaTrajectory& NewTrajectory);
+	const FIsekaiStaminaTrajectory& GetStaminaTrajectory() const { return StaminaTrajectory; }
+	
+	/** Stamina right now: evaluates the trajectory when one is published, the attribute may lag behind it. */
+	float GetCurrentStamina() const;
+	
+	/** Replicated server clock the trajectory is expressed in. */
+	float GetServerTime() const;
+	
+	FSimpleMulticastDelegate OnStaminaTrajectoryChanged;
 	
 	
 	// Health
@@ -101,20 +177,65 @@ protected:
 	UFUNCTION()
 	void OnRep_StaminaRegenDelay(const FGameplayAttributeData& OldValue);
 	
+	UFUNCTION()
+	void OnRep_StaminaTrajectory();
+	
+	UFUNCTION()
+	void OnRep_ProxyHealth();
+	
+	UPROPERTY(ReplicatedUsing=OnRep_StaminaTrajectory)
+	FIsekaiStaminaTrajectory StaminaTrajectory;
+	
+	/** Health rounded up to whole points for everyone but the owner, applied to the local Health attribute on receive. */
+	UPROPERTY(ReplicatedUsing=OnRep_ProxyHealth)
+	uint16 ProxyHealth = 0;
+	
 private:
+	// --- Attribute Rules ---
+	/** What a post-execute handler gets to work with, resolved once per execution. */
+	struct FPostExecuteContext
+	{
+		UIsekaiAbilitySystemComponent* TargetASC = nullptr;
+		AIsekaiCharacterBase* TargetCharacter = nullptr;
+	};
+	
 	/**
-	* Server-only: applies/removes the Exhausted state GE based on stamina thresholds.
+	 * Clamping and post-execute behaviour of one attribute. Rules live in a constexpr table in FindAttributeRule and
+	 * are looked up by the attribute's property offset, so a modification costs one index regardless of attribute count.
+	 */
+	struct FAttributeRule
+	{
+		FGameplayAttributeData UIsekaiAttributeSet::* Attribute = nullptr;
+		float MinValue = 0.f;
+		/** Attribute whose current value caps this one, null for no cap. */
+		FGameplayAttributeData UIsekaiAttributeSet::* MaxAttribute = nullptr;
+		void (UIsekaiAttributeSet::* PostExecute)(const FPostExecuteContext&) = nullptr;
+	};
+	
+	/** Null for attributes without a rule. */
+	static const FAttributeRule* FindAttributeRule(const FGameplayAttribute& Attribute);
+	
+	void PostExecuteHealth(const FPostExecuteContext& Context);
+	void PostExecuteMaxHealth(const FPostExecuteContext& Context);
+	void PostExecuteStamina(const FPostExecuteContext& Context);
+	void PostExecuteMaxStamina(const FPostExecuteContext& Context);
+	
+	/** Attribute values are changed by GAS internals, so every change marks its property for the push model here. */
+	void MarkAttributeDirty(const FGameplayAttribute& Attribute) const;
+	
+	/** Server-only: refreshes ProxyHealth when Health crosses a whole point. */
+	void UpdateProxyHealth(float NewHealth);
+	
+	/**
+	* Server-only: enters/leaves the Exhausted state based on stamina thresholds.
 	* @param TargetASC ASC that owns the attributes (PlayerState for players).
 	* @param NewStamina clamped stamina after GE execution.
 	*/
 	void HandleExhaustionStateChange(UIsekaiAbilitySystemComponent* TargetASC, float NewStamina);
 	
 	/**
-	* Server-only: applies the Dead state GE once when health reaches zero.
+	* Server-only: enters the Dead state once when health reaches zero.
 	* @param TargetASC ASC that owns the attributes.
 	*/
 	void HandleOutOfHealth(UIsekaiAbilitySystemComponent* TargetASC);
-	
-	FActiveGameplayEffectHandle ExhaustedStateEffectHandle;
-	FActiveGameplayEffectHandle DeadStateEffectHandle;
 };
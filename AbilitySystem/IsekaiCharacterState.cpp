@@ -0,0 +1,32 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiCharacterState.h"
+
+#include "AIAssessment/NativeGameplayTags.h"
+
+const FIsekaiCharacterStateRule& FIsekaiCharacterStateRule::Get(const EIsekaiCharacterState State)
+{
+	// Native tags are only registered at module startup, so the table is built on first use
+	static const TStaticArray<FIsekaiCharacterStateRule, static_cast<int32>(EIsekaiCharacterState::MAX)> Rules = []()
+	{
+		TStaticArray<FIsekaiCharacterStateRule, static_cast<int32>(EIsekaiCharacterState::MAX)> Result;
+		
+		// Dead: stop regen and block every ability. Active abilities are canceled by the ASC's HandleOutOfHealth
+		FIsekaiCharacterStateRule& Dead = Result[static_cast<int32>(EIsekaiCharacterState::Dead)];
+		Dead.GrantedTags.AddTag(Tags::State::Dead);
+		Dead.GrantedTags.AddTag(Tags::State::Stamina_RegenBlocked);
+		Dead.GrantedTags.AddTag(Tags::State::Health_RegenBlocked);
+		Dead.BlockedAbilityTags.AddTag(Tags::Ability::Ability);
+		
+		// Exhausted: block stamina abilities and stop the continuous ones
+		FIsekaiCharacterStateRule& Exhausted = Result[static_cast<int32>(EIsekaiCharacterState::Exhausted)];
+		Exhausted.GrantedTags.AddTag(Tags::State::Exhausted);
+		Exhausted.BlockedAbilityTags.AddTag(Tags::Ability::Stamina);
+		Exhausted.CanceledAbilityTags.AddTag(Tags::Ability::Stamina_Drain);
+		
+		return Result;
+	}();
+	
+	return Rules[static_cast<int32>(State)];
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+/** Binary character states, replicated as one bit each by UIsekaiAbilitySystemComponent. */
+enum class EIsekaiCharacterState : uint8
+{
+	Dead,
+	Exhausted,
+	MAX
+};
+
+static_assert(static_cast<int32>(EIsekaiCharacterState::MAX) <= 32, "Character states are replicated as a uint32 bitfield");
+
+/**
+ * What a character state does while it is set. Every machine applies the rule locally from the replicated bit,
+ * so entering a state costs a few tag count changes instead of an active gameplay effect.
+ */
+struct AIASSESSMENT_API FIsekaiCharacterStateRule
+{
+	/** Loose tags granted while set, with normal tag count semantics. */
+	FGameplayTagContainer GrantedTags;
+	
+	/** Abilities with any of these tags cannot activate while set. */
+	FGameplayTagContainer BlockedAbilityTags;
+	
+	/** Active abilities with any of these tags are canceled on entering the state, on the server and owning client. */
+	FGameplayTagContainer CanceledAbilityTags;
+	
+	static const FIsekaiCharacterStateRule& Get(EIsekaiCharacterState State);
+};
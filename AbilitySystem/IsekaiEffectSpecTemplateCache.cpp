@@ -0,0 +1,170 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiEffectSpecTemplateCache.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AIAssessment/NativeGameplayTags.h"
+#include "AIAssessment/AbilitySystem/IsekaiAttributeSet.h"
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "GameFramework/PlayerController.h"
+
+FIsekaiEffectSpecTemplateCache::FEntry* FIsekaiEffectSpecTemplateCache::FindEntry(const UGameplayEffect* EffectDef, const float Level)
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.EffectDef == EffectDef && Entry.Level == Level)
+		{
+			return &Entry;
+		}
+	}
+	return nullptr;
+}
+
+FGameplayEffectSpec* FIsekaiEffectSpecTemplateCache::Find(const UGameplayEffect* EffectDef, const float Level)
+{
+	FEntry* Entry = FindEntry(EffectDef, Level);
+	return Entry ? &Entry->Spec : nullptr;
+}
+
+FGameplayEffectSpec* FIsekaiEffectSpecTemplateCache::Build(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, const float Level, const UObject* SourceObject)
+{
+	if (!ASC || !EffectDef)
+	{
+		return nullptr;
+	}
+	
+	FGameplayEffectContextHandle Context = ASC->MakeEffectContext();
+	Context.AddSourceObject(SourceObject);
+	
+	FEntry* Entry = FindEntry(EffectDef, Level);
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->EffectDef = EffectDef;
+		Entry->Level = Level;
+	}
+	
+	// What MakeOutgoingSpec does, minus the heap allocation of the spec
+	Entry->Spec = FGameplayEffectSpec(EffectDef, Context, Level);
+	Entry->LockedDuration = 0.f;
+	return &Entry->Spec;
+}
+
+FGameplayEffectSpec* FIsekaiEffectSpecTemplateCache::FindOrBuild(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, const float Level, const UObject* SourceObject)
+{
+	// Contexts name the avatar, which changes under a PlayerState-owned ASC on respawn
+	const AActor* Avatar = ASC ? ASC->GetAvatarActor() : nullptr;
+	if (CachedASC.Get() != ASC || CachedAvatar.Get() != Avatar)
+	{
+		Reset();
+		CachedASC = ASC;
+		CachedAvatar = Avatar;
+	}
+	
+	if (FGameplayEffectSpec* Spec = Find(EffectDef, Level))
+	{
+		// Building captured the tags the owner had back then, e.g. before it became exhausted
+		FGameplayTagContainer& SourceActorTags = Spec->CapturedSourceTags.GetActorTags();
+		SourceActorTags.Reset();
+		ASC->GetOwnedGameplayTags(SourceActorTags);
+		return Spec;
+	}
+	return Build(ASC, EffectDef, Level, SourceObject);
+}
+
+FGameplayEffectSpec* FIsekaiEffectSpecTemplateCache::FindOrBuildWithDuration(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, const float Level, const UObject* SourceObject, const float Duration)
+{
+	if (!FindOrBuild(ASC, EffectDef, Level, SourceObject))
+	{
+		return nullptr;
+	}
+	
+	const float WantedDuration = FMath::Max(Duration, 0.f);
+	FEntry* Entry = FindEntry(EffectDef, Level);
+	if (FMath::IsNearlyEqual(Entry->LockedDuration, WantedDuration))
+	{
+		return &Entry->Spec;
+	}
+	
+	// The previous duration is locked into the spec, start over from a fresh one
+	FGameplayEffectSpec* Spec = Build(ASC, EffectDef, Level, SourceObject);
+	if (Spec && WantedDuration > 0.f)
+	{
+		Spec->SetDuration(WantedDuration, /*bLockDuration*/ true);
+		FindEntry(EffectDef, Level)->LockedDuration = WantedDuration;
+	}
+	return Spec;
+}
+
+void FIsekaiEffectSpecTemplateCache::Invalidate(const UGameplayEffect* EffectDef)
+{
+	Entries.RemoveAllSwap([EffectDef](const FEntry& Entry) { return Entry.EffectDef == EffectDef; }, EAllowShrinking::No);
+}
+
+void FIsekaiEffectSpecTemplateCache::Reset()
+{
+	Entries.Reset();
+	CachedASC.Reset();
+	CachedAvatar.Reset();
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchCostSpecs(
+	TEXT("Isekai.Ability.BenchCostSpecs"),
+	TEXT("Applies a value-neutral instant SetByCaller stamina cost to the local player's ASC, building the spec per commit vs. patching a cached template. Args: [Commits=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		UAbilitySystemComponent* ASC = PC ? UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC->GetPawn()) : nullptr;
+		if (!ASC || !ASC->IsOwnerActorAuthoritative())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.Ability.BenchCostSpecs: Needs a locally controlled player with authority (standalone or listen server)"));
+			return;
+		}
+		
+		const int32 NumCommits = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		
+		// Shaped like the instant stamina cost effects: one additive SetByCaller(Data.Cost.Stamina) modifier
+		UGameplayEffect* CostEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_BenchStaminaCost"));
+		CostEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+		FGameplayModifierInfo& Modifier = CostEffect->Modifiers.AddDefaulted_GetRef();
+		Modifier.Attribute = UIsekaiAttributeSet::GetStaminaAttribute();
+		Modifier.ModifierOp = EGameplayModOp::Additive;
+		FSetByCallerFloat SetByCaller;
+		SetByCaller.DataTag = Tags::Data::Cost_Stamina;
+		Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+		
+		// Value-neutral, so the player's stamina and exhaustion state are left alone
+		constexpr float CostMagnitude = 0.f;
+		
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumCommits; ++Index)
+		{
+			// The old ApplyStaminaCostEffectInternal: context, spec handle and SetByCaller from scratch
+			FGameplayEffectContextHandle Context = ASC->MakeEffectContext();
+			Context.AddSourceObject(ASC);
+			const FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(CostEffect, Context, 1.f));
+			SpecHandle.Data->SetSetByCallerMagnitude(Tags::Data::Cost_Stamina, -CostMagnitude);
+			ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+		}
+		const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		FIsekaiEffectSpecTemplateCache Cache;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumCommits; ++Index)
+		{
+			if (FGameplayEffectSpec* Spec = Cache.FindOrBuild(ASC, CostEffect, 1.f, ASC))
+			{
+				Spec->SetSetByCallerMagnitude(Tags::Data::Cost_Stamina, -CostMagnitude);
+				ASC->ApplyGameplayEffectSpecToSelf(*Spec);
+			}
+		}
+		const double TemplateSeconds = FPlatformTime::Seconds() - StartTime;
+		
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.Ability.BenchCostSpecs: %d instant cost commits"), NumCommits);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Spec per commit:  %.3f ms (%.0f commits/s)"), BuildSeconds * 1000.0, NumCommits / FMath::Max(BuildSeconds, UE_SMALL_NUMBER));
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  Cached template:  %.3f ms (%.0f commits/s)"), TemplateSeconds * 1000.0, NumCommits / FMath::Max(TemplateSeconds, UE_SMALL_NUMBER));
+	}));
+#endif
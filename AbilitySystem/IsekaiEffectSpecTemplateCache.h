@@ -0,0 +1,67 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * Outgoing effect specs built once per (effect class, level) and reused for every application.
+ * Callers only patch SetByCaller magnitudes (or the duration) on the template before applying it, so repeated costs
+ * skip MakeEffectContext and MakeOutgoingSpec and their allocations entirely. The effect context is created with the
+ * template and shared by every application, which is safe because cost contexts are never modified after creation.
+ * The context records the avatar as instigator and causer, so templates are dropped when the ASC's avatar changes,
+ * e.g. a player ASC living on the PlayerState across respawns.
+ * Source attributes are captured when the template is built, so only cache effects driven by SetByCaller magnitudes
+ * or non-snapshotted captures. Source actor tags are captured again on every FindOrBuild hit, so tag requirements
+ * see the owner's current tags.
+ */
+struct AIASSESSMENT_API FIsekaiEffectSpecTemplateCache
+{
+	/** Returned specs stay valid until the next Build, Invalidate or Reset. */
+	FGameplayEffectSpec* Find(const UGameplayEffect* EffectDef, float Level);
+	
+	/** Builds (or rebuilds) the template. Null if the spec could not be made. */
+	FGameplayEffectSpec* Build(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, float Level, const UObject* SourceObject);
+	
+	/** Find and re-capture the source actor tags, or Build on a miss. Templates built for another ASC or avatar are dropped first. */
+	FGameplayEffectSpec* FindOrBuild(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, float Level, const UObject* SourceObject);
+	
+	/**
+	 * FindOrBuild for a template whose duration is locked to Duration. A locked duration can't be unlocked, so the
+	 * template is rebuilt whenever Duration changes. Duration <= 0 keeps the effect's authored duration.
+	 */
+	FGameplayEffectSpec* FindOrBuildWithDuration(UAbilitySystemComponent* ASC, const UGameplayEffect* EffectDef, float Level, const UObject* SourceObject, float Duration);
+	
+	/** Drops every level of EffectDef. */
+	void Invalidate(const UGameplayEffect* EffectDef);
+	void Reset();
+	
+	int32 Num() const { return Entries.Num(); }
+	
+	/** Templates are keyed by the effect's CDO, like MakeOutgoingSpec does. */
+	static const UGameplayEffect* GetEffectDef(const TSubclassOf<UGameplayEffect> EffectClass)
+	{
+		return EffectClass ? EffectClass->GetDefaultObject<UGameplayEffect>() : nullptr;
+	}
+	
+private:
+	struct FEntry
+	{
+		const UGameplayEffect* EffectDef = nullptr;
+		float Level = 0.f;
+		/** Duration locked by FindOrBuildWithDuration, 0 for the authored one. */
+		float LockedDuration = 0.f;
+		FGameplayEffectSpec Spec;
+	};
+	
+	FEntry* FindEntry(const UGameplayEffect* EffectDef, float Level);
+	
+	TWeakObjectPtr<UAbilitySystemComponent> CachedASC;
+	TWeakObjectPtr<const AActor> CachedAvatar;
+	
+	/** An ability uses two or three cost effects at most, a linear search beats hashing. */
+	TArray<FEntry, TInlineAllocator<2>> Entries;
+};
@@ -3,8 +3,10 @@
 
 #include "IsekaiPatrolPath.h"
 
+#include "NavigationData.h"
 #include "NavigationSystem.h"
 #include "Components/SplineComponent.h"
+#include "TimerManager.h"
 
 
 AIsekaiPatrolPath::AIsekaiPatrolPath()
@@ -27,13 +29,274 @@ int32 AIsekaiPatrolPath::GetNumberOfSplinePoints() const
 	return PatrolSpline->GetNumberOfSplinePoints();
 }
 
+void AIsekaiPatrolPath::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	RebuildSpatialIndex();
+	
+	// Patrol logic only runs on the server
+	if (!HasAuthority()) return;
+	
+	bBakeUsable = BakedPoints.Num() == GetNumberOfSplinePoints() && BakedSplineHash == ComputeSplineHash();
+	
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &ThisClass::HandleNavigationGenerationFinished);
+		
+		// If the navmesh is still building, the generation finished event will trigger the bake
+		if (!bBakeUsable && bBakeOnLevelLoad && !NavSys->IsNavigationBuildInProgress())
+		{
+			StartRuntimeRebake();
+		}
+	}
+}
+
+void AIsekaiPatrolPath::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &ThisClass::HandleNavigationGenerationFinished);
+	}
+	GetWorldTimerManager().ClearTimer(RebakeTimerHandle);
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 #if WITH_EDITOR
 void AIsekaiPatrolPath::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
+	
+	RebuildSpatialIndex();
+	
+	// Editing the spline or moving the actor makes the serialized bake stale
+	bBakeUsable = BakedPoints.Num() == GetNumberOfSplinePoints() && BakedSplineHash == ComputeSplineHash();
 }
 #endif
 
+void AIsekaiPatrolPath::BakeNavigationData()
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+	{
+		UE_LOG(LogNavigation, Warning, TEXT("BakeNavigationData: No Navigation Data found for %s."), *GetName());
+		return;
+	}
+	
+#if WITH_EDITOR
+	if (!GetWorld()->IsGameWorld())
+	{
+		Modify();
+	}
+#endif
+	
+	// A full synchronous bake supersedes any runtime rebake in progress
+	GetWorldTimerManager().ClearTimer(RebakeTimerHandle);
+	RuntimeRebakeCursor = INDEX_NONE;
+	
+	// 1. Project waypoints
+	ProjectBakedPoints(*NavSys);
+	
+	// 2. Test segments between consecutive points
+	int32 NumReachable = 0;
+	const int32 NumSegments = GetNumBakedSegments();
+	for (int32 i = 0; i < NumSegments; ++i)
+	{
+		NumReachable += BakeSegment(*NavSys, *NavData, i) ? 1 : 0;
+	}
+	
+	FinishBake(NumReachable);
+}
+
+void AIsekaiPatrolPath::ProjectBakedPoints(const UNavigationSystemV1& NavSys)
+{
+	const int32 NumPoints = GetNumberOfSplinePoints();
+	BakedPoints.SetNum(NumPoints);
+	
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const FVector PointLocation = PatrolSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+		
+		FNavLocation ProjectedLocation;
+		FIsekaiBakedPatrolPoint& Baked = BakedPoints[i];
+		Baked.bOnNavmesh = NavSys.ProjectPointToNavigation(PointLocation, ProjectedLocation, GetNavProjectionExtent());
+		Baked.NavLocation = Baked.bOnNavmesh ? ProjectedLocation.Location : PointLocation;
+		Baked.bForwardReachable = false;
+		Baked.bBackwardReachable = false;
+		Baked.ForwardPathLength = 0.f;
+	}
+}
+
+int32 AIsekaiPatrolPath::GetNumBakedSegments() const
+{
+	// The last point only links back to 0 on looping paths
+	const int32 NumPoints = BakedPoints.Num();
+	return IsLooping() ? NumPoints : FMath::Max(0, NumPoints - 1);
+}
+
+bool AIsekaiPatrolPath::BakeSegment(const UNavigationSystemV1& NavSys, const ANavigationData& NavData, const int32 Index)
+{
+	FIsekaiBakedPatrolPoint& From = BakedPoints[Index];
+	const FIsekaiBakedPatrolPoint& To = BakedPoints[(Index + 1) % BakedPoints.Num()];
+	if (!From.bOnNavmesh || !To.bOnNavmesh) return false;
+	
+	const FPathFindingResult Forward = NavSys.FindPathSync(FPathFindingQuery(this, NavData, From.NavLocation, To.NavLocation));
+	if (Forward.IsSuccessful() && Forward.Path.IsValid() && !Forward.Path->IsPartial())
+	{
+		From.bForwardReachable = true;
+		From.ForwardPathLength = Forward.Path->GetLength();
+	}
+	
+	From.bBackwardReachable = NavSys.TestPathSync(FPathFindingQuery(this, NavData, To.NavLocation, From.NavLocation));
+	return From.bForwardReachable;
+}
+
+void AIsekaiPatrolPath::FinishBake(const int32 NumReachable)
+{
+	BakedSplineHash = ComputeSplineHash();
+	bBakeUsable = true;
+	
+	UE_LOG(LogNavigation, Log, TEXT("BakeNavigationData: Baked %d points, %d/%d segments reachable on %s."),
+		BakedPoints.Num(), NumReachable, GetNumBakedSegments(), *GetName());
+}
+
+void AIsekaiPatrolPath::InvalidateNavigationBake()
+{
+	bBakeUsable = false;
+}
+
+const FIsekaiBakedPatrolPoint* AIsekaiPatrolPath::GetBakedPoint(const int32 Index) const
+{
+	const int32 NumPoints = BakedPoints.Num();
+	if (!bBakeUsable || NumPoints == 0) return nullptr;
+	
+	// Wraps like the spline does, negative indices included
+	return &BakedPoints[(Index % NumPoints + NumPoints) % NumPoints];
+}
+
+bool AIsekaiPatrolPath::GetBakedSegmentReachability(const int32 FromIndex, const int32 ToIndex, bool& bOutReachable) const
+{
+	const int32 NumPoints = BakedPoints.Num();
+	if (!bBakeUsable || NumPoints < 2) return false;
+	if (!BakedPoints.IsValidIndex(FromIndex) || !BakedPoints.IsValidIndex(ToIndex)) return false;
+	
+	if ((FromIndex + 1) % NumPoints == ToIndex && (IsLooping() || FromIndex < NumPoints - 1))
+	{
+		bOutReachable = BakedPoints[FromIndex].bForwardReachable;
+		return true;
+	}
+	if ((ToIndex + 1) % NumPoints == FromIndex && (IsLooping() || ToIndex < NumPoints - 1))
+	{
+		bOutReachable = BakedPoints[ToIndex].bBackwardReachable;
+		return true;
+	}
+	
+	return false;
+}
+
+float AIsekaiPatrolPath::FindInputKeyClosestToWorldLocation(const FVector& WorldLocation) const
+{
+	return SpatialIndex.IsValid()
+		? SpatialIndex.FindClosestInputKey(*PatrolSpline, WorldLocation)
+		: PatrolSpline->FindInputKeyClosestToWorldLocation(WorldLocation);
+}
+
+void AIsekaiPatrolPath::RebuildSpatialIndex()
+{
+	SpatialIndex.Build(*PatrolSpline, SpatialIndexSamplesPerSegment);
+}
+
+uint32 AIsekaiPatrolPath::ComputeSplineHash() const
+{
+	uint32 Hash = GetTypeHash(IsLooping());
+	const int32 NumPoints = GetNumberOfSplinePoints();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(PatrolSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World)));
+	}
+	return Hash;
+}
+
+void AIsekaiPatrolPath::RequestRebake()
+{
+	// Already running, start over when it finishes since its early segments may predate this rebuild
+	if (RuntimeRebakeCursor != INDEX_NONE)
+	{
+		bRuntimeRebakeRequested = true;
+		return;
+	}
+	
+	// Already scheduled, this rebuild is folded into it
+	if (GetWorldTimerManager().IsTimerActive(RebakeTimerHandle)) return;
+	
+	// Dynamic navmeshes finish builds in a row, wait for things to settle and never rebake more than once per interval
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float Delay = FMath::Max(0.5f, static_cast<float>(LastRuntimeRebakeTime + RuntimeRebakeInterval - Now));
+	GetWorldTimerManager().SetTimer(RebakeTimerHandle, this, &ThisClass::StartRuntimeRebake, Delay, false);
+}
+
+void AIsekaiPatrolPath::StartRuntimeRebake()
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys || !NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) return;
+	
+	LastRuntimeRebakeTime = GetWorld()->GetTimeSeconds();
+	bRuntimeRebakeRequested = false;
+	InvalidateNavigationBake();
+	
+	// Projection is one cheap query per point, only the path tests are spread over frames
+	ProjectBakedPoints(*NavSys);
+	RuntimeRebakeCursor = 0;
+	RuntimeRebakeReachable = 0;
+	
+	ContinueRuntimeRebake();
+}
+
+void AIsekaiPatrolPath::ContinueRuntimeRebake()
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData || RuntimeRebakeCursor == INDEX_NONE)
+	{
+		RuntimeRebakeCursor = INDEX_NONE;
+		return;
+	}
+	
+	const int32 NumSegments = GetNumBakedSegments();
+	const int32 End = FMath::Min(NumSegments, RuntimeRebakeCursor + RuntimeRebakeSegmentsPerFrame);
+	for (; RuntimeRebakeCursor < End; ++RuntimeRebakeCursor)
+	{
+		RuntimeRebakeReachable += BakeSegment(*NavSys, *NavData, RuntimeRebakeCursor) ? 1 : 0;
+	}
+	
+	if (RuntimeRebakeCursor < NumSegments)
+	{
+		RebakeTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::ContinueRuntimeRebake);
+		return;
+	}
+	
+	RuntimeRebakeCursor = INDEX_NONE;
+	FinishBake(RuntimeRebakeReachable);
+	
+	if (bRuntimeRebakeRequested)
+	{
+		InvalidateNavigationBake();
+		RequestRebake();
+	}
+}
+
+void AIsekaiPatrolPath::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	InvalidateNavigationBake();
+	
+	if (bBakeOnLevelLoad)
+	{
+		RequestRebake();
+	}
+}
+
 
 void AIsekaiPatrolPath::SnapPointsToGround()
 {
@@ -63,6 +326,85 @@ void AIsekaiPatrolPath::SnapPointsToGround()
 		}
 	}
 	
+	InvalidateNavigationBake();
+	RebuildSpatialIndex();
+	
 	UE_LOG(LogNavigation, Log, TEXT("SnapPointsToGround: Snapped %d points to navigation."), NumPoints);
 }
 
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchClosestKey(
+	TEXT("Isekai.PatrolPath.BenchClosestKey"),
+	TEXT("Compares the patrol path segment index against USplineComponent::FindInputKeyClosestToWorldLocation. Args: [NumPoints=200] [NumQueries=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World) return;
+		
+		const int32 NumPoints = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 200;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10000;
+		
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AIsekaiPatrolPath* Path = World->SpawnActor<AIsekaiPatrolPath>(SpawnParams);
+		if (!Path) return;
+		
+		// Deterministic wandering loop roughly the size of a large level
+		FRandomStream Stream(1337);
+		USplineComponent* Spline = Path->GetSpline();
+		Spline->ClearSplinePoints(false);
+		FVector Point = FVector::ZeroVector;
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			Point += FVector(Stream.FRandRange(-400.f, 600.f), Stream.FRandRange(-400.f, 600.f), Stream.FRandRange(-20.f, 20.f));
+			Spline->AddSplinePoint(Point, ESplineCoordinateSpace::World, false);
+		}
+		Spline->UpdateSpline();
+		Path->RebuildSpatialIndex();
+		
+		const FBox Bounds(Path->GetSpatialIndex().GetPoints());
+		TArray<FVector> Queries;
+		Queries.Reserve(NumQueries);
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			Queries.Add(Stream.RandPointInBox(Bounds.ExpandBy(500.f)));
+		}
+		
+		TArray<float> SplineKeys;
+		TArray<float> IndexKeys;
+		SplineKeys.SetNumUninitialized(NumQueries);
+		IndexKeys.SetNumUninitialized(NumQueries);
+		
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			SplineKeys[i] = Spline->FindInputKeyClosestToWorldLocation(Queries[i]);
+		}
+		const double SplineSeconds = FPlatformTime::Seconds() - Start;
+		
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			IndexKeys[i] = Path->FindInputKeyClosestToWorldLocation(Queries[i]);
+		}
+		const double IndexSeconds = FPlatformTime::Seconds() - Start;
+		
+		// Error is measured as the extra distance the index result is from the query compared to the spline's own answer
+		double MaxError = 0.0;
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			const double SplineDist = FVector::Dist(Queries[i], Spline->GetLocationAtSplineInputKey(SplineKeys[i], ESplineCoordinateSpace::World));
+			const double IndexDist = FVector::Dist(Queries[i], Spline->GetLocationAtSplineInputKey(IndexKeys[i], ESplineCoordinateSpace::World));
+			MaxError = FMath::Max(MaxError, IndexDist - SplineDist);
+		}
+		
+		UE_LOG(LogNavigation, Display, TEXT("BenchClosestKey: %d points, %d queries. Spline: %.3f us/query, Index: %.3f us/query (x%.1f). Max extra distance: %.3f cm"),
+			NumPoints, NumQueries,
+			SplineSeconds * 1e6 / NumQueries,
+			IndexSeconds * 1e6 / NumQueries,
+			IndexSeconds > 0.0 ? SplineSeconds / IndexSeconds : 0.0,
+			MaxError);
+		
+		Path->Destroy();
+	}));
+#endif
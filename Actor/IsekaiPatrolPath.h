@@ -5,8 +5,36 @@
 #include "CoreMinimal.h"
 #include "Components/SplineComponent.h"
 #include "GameFramework/Actor.h"
+#include "AIAssessment/Actor/IsekaiPatrolPathSpatialIndex.h"
 #include "IsekaiPatrolPath.generated.h"
 
+class ANavigationData;
+
+/** Navigation data baked for a single waypoint and the segment leaving it (i -> i+1). */
+USTRUCT()
+struct FIsekaiBakedPatrolPoint
+{
+	GENERATED_BODY()
+
+	/** Waypoint projected onto the navmesh, or the raw spline location if projection failed. */
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	FVector NavLocation = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	bool bOnNavmesh = false;
+
+	/** Path exists from this point to the next one. */
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	bool bForwardReachable = false;
+
+	/** Path exists from the next point back to this one. */
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	bool bBackwardReachable = false;
+
+	/** Nav path length to the next point, 0 if unreachable. */
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	float ForwardPathLength = 0.f;
+};
 
 UCLASS()
 class AIASSESSMENT_API AIsekaiPatrolPath : public AActor
@@ -30,12 +58,98 @@ public:
 	
 	USplineComponent* GetSpline() const { return PatrolSpline; }
 	
+	// --- Navigation Bake ---
+	/** Projects every waypoint and tests every segment against the current navmesh, storing the result with the level. */
+	UFUNCTION(CallInEditor, Category="Navigation")
+	void BakeNavigationData();
+	
+	void InvalidateNavigationBake();
+	
+	bool HasValidNavigationBake() const { return bBakeUsable; }
+	
+	/** Returns the baked data for a waypoint, nullptr if there is no valid bake. */
+	const FIsekaiBakedPatrolPoint* GetBakedPoint(int32 Index) const;
+	
+	/**
+	 * Answers reachability between two consecutive waypoints from the bake.
+	 * @return false if the bake can't answer (no valid bake or the points are not adjacent).
+	 */
+	bool GetBakedSegmentReachability(int32 FromIndex, int32 ToIndex, bool& bOutReachable) const;
+	
+	// --- Spatial Queries ---
+	/** Closest spline input key to a world location. Uses the segment index when built, falls back to the spline otherwise. */
+	float FindInputKeyClosestToWorldLocation(const FVector& WorldLocation) const;
+	
+	/** Rebuilds the polyline index, call after moving spline points at runtime. */
+	void RebuildSpatialIndex();
+	
+	const FIsekaiPatrolPathSpatialIndex& GetSpatialIndex() const { return SpatialIndex; }
+	
+	/** Shared extent used when projecting waypoints onto the navmesh. */
+	static FVector GetNavProjectionExtent() { return FVector(200.f, 200.f, 500.f); }
+	
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Path")
 	TObjectPtr<USplineComponent> PatrolSpline;
+	
+	/** Bake at BeginPlay if the serialized bake is missing or stale, and rebake after navmesh rebuilds. */
+	UPROPERTY(EditAnywhere, Category="Navigation")
+	bool bBakeOnLevelLoad = true;
+	
+	/** Segments path-tested per frame by a runtime rebake. The full synchronous bake is editor-only. */
+	UPROPERTY(EditAnywhere, Category="Navigation", meta=(ClampMin="1", EditCondition="bBakeOnLevelLoad"))
+	int32 RuntimeRebakeSegmentsPerFrame = 2;
+	
+	/** Minimum seconds between runtime rebakes. Navmesh rebuilds in between are coalesced into one rebake. */
+	UPROPERTY(EditAnywhere, Category="Navigation", meta=(ClampMin="0.0", Units="s", EditCondition="bBakeOnLevelLoad"))
+	float RuntimeRebakeInterval = 5.f;
+	
+	UPROPERTY(VisibleAnywhere, Category="Navigation")
+	TArray<FIsekaiBakedPatrolPoint> BakedPoints;
+	
+	/** Polyline samples per spline segment for the spatial index. Higher = tighter approximation, more memory. */
+	UPROPERTY(EditAnywhere, Category="Path", meta=(ClampMin="1", ClampMax="64"))
+	int32 SpatialIndexSamplesPerSegment = 8;
+	
+	/** Hash of the spline the bake was made from, a mismatch means the path was edited since. */
+	UPROPERTY()
+	uint32 BakedSplineHash = 0;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 #if WITH_EDITOR
 	virtual void OnConstruction(const FTransform& Transform) override;
 #endif
 
+private:
+	uint32 ComputeSplineHash() const;
+	
+	/** Projects every waypoint and clears the segment results. */
+	void ProjectBakedPoints(const UNavigationSystemV1& NavSys);
+	/** Path-tests the segment leaving waypoint Index. Returns true if it is forward reachable. */
+	bool BakeSegment(const UNavigationSystemV1& NavSys, const ANavigationData& NavData, int32 Index);
+	int32 GetNumBakedSegments() const;
+	void FinishBake(int32 NumReachable);
+	
+	/** Schedules a time-sliced runtime rebake, at most once per RuntimeRebakeInterval. */
+	void RequestRebake();
+	void StartRuntimeRebake();
+	void ContinueRuntimeRebake();
+	
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+	
+	bool bBakeUsable = false;
+	FTimerHandle RebakeTimerHandle;
+	
+	// --- Runtime rebake state ---
+	/** Next segment to test, INDEX_NONE while no runtime rebake is running. */
+	int32 RuntimeRebakeCursor = INDEX_NONE;
+	int32 RuntimeRebakeReachable = 0;
+	/** A navmesh rebuild finished while a rebake was running, start over once it is done. */
+	bool bRuntimeRebakeRequested = false;
+	double LastRuntimeRebakeTime = -UE_BIG_NUMBER;
+	
+	FIsekaiPatrolPathSpatialIndex SpatialIndex;
 };
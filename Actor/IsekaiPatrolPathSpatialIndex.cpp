@@ -0,0 +1,240 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiPatrolPathSpatialIndex.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Components/SplineComponent.h"
+
+void FIsekaiPatrolPathSpatialIndex::Build(const USplineComponent& Spline, const int32 SamplesPerSegment)
+{
+	Reset();
+	
+	NumSplineSegments = Spline.GetNumberOfSplineSegments();
+	SamplesPerSplineSegment = FMath::Max(1, SamplesPerSegment);
+	bClosedLoop = Spline.IsClosedLoop();
+	if (NumSplineSegments <= 0) return;
+	
+	// 1. Flatten
+	const int32 NumPoints = NumSplineSegments * SamplesPerSplineSegment + 1;
+	Points.Reserve(NumPoints);
+	InputKeys.Reserve(NumPoints);
+	Distances.Reserve(NumPoints);
+	
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const float Key = static_cast<float>(i) / SamplesPerSplineSegment;
+		const FVector Point = Spline.GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::World);
+		
+		Distances.Add(i == 0 ? 0.f : Distances.Last() + FVector::Dist(Points.Last(), Point));
+		InputKeys.Add(Key);
+		Points.Add(Point);
+	}
+	
+	// 2. Build the tree over segment centroids
+	const int32 NumSegments = NumPoints - 1;
+	TArray<FVector> Centroids;
+	Centroids.SetNumUninitialized(NumSegments);
+	SegmentOrder.SetNumUninitialized(NumSegments);
+	for (int32 i = 0; i < NumSegments; ++i)
+	{
+		Centroids[i] = (Points[i] + Points[i + 1]) * 0.5;
+		SegmentOrder[i] = i;
+	}
+	
+	Nodes.Reserve(2 * NumSegments / MaxLeafSegments + 1);
+	BuildNode(0, NumSegments, Centroids);
+}
+
+void FIsekaiPatrolPathSpatialIndex::Reset()
+{
+	Points.Reset();
+	InputKeys.Reset();
+	Distances.Reset();
+	SegmentOrder.Reset();
+	Nodes.Reset();
+	NumSplineSegments = 0;
+}
+
+int32 FIsekaiPatrolPathSpatialIndex::BuildNode(const int32 Start, const int32 Count, const TArray<FVector>& Centroids)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	
+	FBox Bounds(ForceInit);
+	FBox CentroidBounds(ForceInit);
+	for (int32 i = Start; i < Start + Count; ++i)
+	{
+		const int32 Segment = SegmentOrder[i];
+		Bounds += Points[Segment];
+		Bounds += Points[Segment + 1];
+		CentroidBounds += Centroids[Segment];
+	}
+	Nodes[NodeIndex].Bounds = Bounds;
+	
+	if (Count <= MaxLeafSegments)
+	{
+		Nodes[NodeIndex].Start = Start;
+		Nodes[NodeIndex].Count = Count;
+		return NodeIndex;
+	}
+	
+	// Median split on the longest centroid axis
+	const FVector Extent = CentroidBounds.GetSize();
+	const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+	const int32 Half = Count / 2;
+	
+	TArrayView<int32> Range(SegmentOrder.GetData() + Start, Count);
+	Algo::Sort(Range, [&Centroids, Axis](const int32 A, const int32 B)
+	{
+		return Centroids[A][Axis] < Centroids[B][Axis];
+	});
+	
+	BuildNode(Start, Half, Centroids);
+	const int32 RightChild = BuildNode(Start + Half, Count - Half, Centroids);
+	
+	// Nodes may have reallocated while building children
+	Nodes[NodeIndex].RightChild = RightChild;
+	return NodeIndex;
+}
+
+int32 FIsekaiPatrolPathSpatialIndex::FindClosestSegment(const FVector& WorldLocation, float& OutKey, float& OutDistanceSq, float* OutPathDistance) const
+{
+	if (!IsValid()) return INDEX_NONE;
+	
+	int32 BestSegment = INDEX_NONE;
+	double BestDistSq = TNumericLimits<double>::Max();
+	double BestAlpha = 0.0;
+	
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(0);
+	
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+		const FNode& Node = Nodes[NodeIndex];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(WorldLocation) >= BestDistSq) continue;
+		
+		if (Node.Count > 0)
+		{
+			for (int32 i = Node.Start; i < Node.Start + Node.Count; ++i)
+			{
+				const int32 Segment = SegmentOrder[i];
+				const FVector& A = Points[Segment];
+				const FVector AB = Points[Segment + 1] - A;
+				const double LengthSq = AB.SizeSquared();
+				const double Alpha = LengthSq > UE_SMALL_NUMBER ? FMath::Clamp(FVector::DotProduct(WorldLocation - A, AB) / LengthSq, 0.0, 1.0) : 0.0;
+				const double DistSq = FVector::DistSquared(WorldLocation, A + AB * Alpha);
+				
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					BestSegment = Segment;
+					BestAlpha = Alpha;
+				}
+			}
+			continue;
+		}
+		
+		// Visit the nearer child first so the far one is more likely to be pruned
+		const int32 Left = NodeIndex + 1;
+		const int32 Right = Node.RightChild;
+		const bool bLeftFirst = Nodes[Left].Bounds.ComputeSquaredDistanceToPoint(WorldLocation) <= Nodes[Right].Bounds.ComputeSquaredDistanceToPoint(WorldLocation);
+		Stack.Add(bLeftFirst ? Right : Left);
+		Stack.Add(bLeftFirst ? Left : Right);
+	}
+	
+	OutKey = FMath::Lerp(InputKeys[BestSegment], InputKeys[BestSegment + 1], static_cast<float>(BestAlpha));
+	OutDistanceSq = static_cast<float>(BestDistSq);
+	if (OutPathDistance)
+	{
+		*OutPathDistance = FMath::Lerp(Distances[BestSegment], Distances[BestSegment + 1], static_cast<float>(BestAlpha));
+	}
+	return BestSegment;
+}
+
+void FIsekaiPatrolPathSpatialIndex::SampleAtDistances(const TConstArrayView<float> InDistances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections) const
+{
+	check(InDistances.Num() == OutLocations.Num() && InDistances.Num() == OutDirections.Num());
+	
+	const int32 NumSegments = Points.Num() - 1;
+	if (NumSegments <= 0)
+	{
+		for (int32 i = 0; i < InDistances.Num(); ++i)
+		{
+			OutLocations[i] = Points.Num() > 0 ? Points[0] : FVector::ZeroVector;
+			OutDirections[i] = FVector::ForwardVector;
+		}
+		return;
+	}
+	
+	const float Length = GetLength();
+	int32 Segment = 0;
+	for (int32 i = 0; i < InDistances.Num(); ++i)
+	{
+		const float Distance = FMath::Clamp(InDistances[i], 0.f, Length);
+		
+		// Walk forward from the previous sample, restart with a binary search when the input goes backwards
+		if (Distance < Distances[Segment])
+		{
+			Segment = FMath::Clamp(Algo::UpperBound(Distances, Distance) - 1, 0, NumSegments - 1);
+		}
+		while (Segment < NumSegments - 1 && Distance > Distances[Segment + 1])
+		{
+			++Segment;
+		}
+		
+		const float SegmentLength = Distances[Segment + 1] - Distances[Segment];
+		const float Alpha = SegmentLength > UE_SMALL_NUMBER ? (Distance - Distances[Segment]) / SegmentLength : 0.f;
+		const FVector& A = Points[Segment];
+		const FVector& B = Points[Segment + 1];
+		
+		OutLocations[i] = FMath::Lerp(A, B, static_cast<double>(Alpha));
+		OutDirections[i] = (B - A).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+	}
+}
+
+float FIsekaiPatrolPathSpatialIndex::FindClosestInputKey(const USplineComponent& Spline, const FVector& WorldLocation) const
+{
+	float PolylineKey = 0.f;
+	float PolylineDistSq = 0.f;
+	const int32 Segment = FindClosestSegment(WorldLocation, PolylineKey, PolylineDistSq);
+	if (Segment == INDEX_NONE)
+	{
+		return Spline.FindInputKeyClosestToWorldLocation(WorldLocation);
+	}
+	
+	// Refine on the spline segment owning the winner. Near a segment boundary the true closest point can sit
+	// on the neighbour, so that one is refined too. Both searches run in local space like the engine's own query.
+	const FInterpCurveVector& Curve = Spline.GetSplinePointsPosition();
+	const FVector LocalLocation = Spline.GetComponentTransform().InverseTransformPosition(WorldLocation);
+	
+	const int32 SplineSegment = FMath::Min(Segment / SamplesPerSplineSegment, NumSplineSegments - 1);
+	const int32 SubSegment = Segment % SamplesPerSplineSegment;
+	
+	TArray<int32, TInlineAllocator<3>> Candidates;
+	Candidates.Add(SplineSegment);
+	if (SubSegment == 0 && (SplineSegment > 0 || bClosedLoop))
+	{
+		Candidates.Add((SplineSegment - 1 + NumSplineSegments) % NumSplineSegments);
+	}
+	if (SubSegment == SamplesPerSplineSegment - 1 && (SplineSegment < NumSplineSegments - 1 || bClosedLoop))
+	{
+		Candidates.AddUnique((SplineSegment + 1) % NumSplineSegments);
+	}
+	
+	float BestKey = PolylineKey;
+	float BestDistSq = TNumericLimits<float>::Max();
+	for (const int32 Candidate : Candidates)
+	{
+		float DistSq = 0.f;
+		const float Key = Curve.InaccurateFindNearestOnSegment(LocalLocation, Candidate, DistSq);
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			BestKey = Key;
+		}
+	}
+	
+	return BestKey;
+}
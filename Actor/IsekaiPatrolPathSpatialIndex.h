@@ -0,0 +1,64 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Flattened polyline approximation of a spline with a small AABB tree over its segments.
+ * Closest-key queries walk the tree in O(log n), then refine the exact key on the winning spline segment.
+ */
+struct AIASSESSMENT_API FIsekaiPatrolPathSpatialIndex
+{
+	/** Samples the spline in world space. SamplesPerSegment bounds the approximation error before refinement. */
+	void Build(const USplineComponent& Spline, int32 SamplesPerSegment);
+	void Reset();
+
+	bool IsValid() const { return Nodes.Num() > 0; }
+
+	/** Closest spline input key to WorldLocation, refined on the spline itself. Spline must be the one the index was built from. */
+	float FindClosestInputKey(const USplineComponent& Spline, const FVector& WorldLocation) const;
+
+	/** Closest point on the polyline only, no refinement. Returns the polyline segment index, INDEX_NONE if empty. */
+	int32 FindClosestSegment(const FVector& WorldLocation, float& OutKey, float& OutDistanceSq, float* OutPathDistance = nullptr) const;
+	
+	/**
+	 * Samples the polyline at the given path distances, clamped to [0, Length].
+	 * Sorted input walks the polyline forward instead of searching, so batching many samples per path is cheap.
+	 */
+	void SampleAtDistances(TConstArrayView<float> InDistances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections) const;
+
+	// --- Polyline Access ---
+	const TArray<FVector>& GetPoints() const { return Points; }
+	const TArray<float>& GetInputKeys() const { return InputKeys; }
+	/** Cumulative polyline length at each point. */
+	const TArray<float>& GetDistances() const { return Distances; }
+	float GetLength() const { return Distances.Num() > 0 ? Distances.Last() : 0.f; }
+
+private:
+	struct FNode
+	{
+		FBox Bounds;
+		/** Range in SegmentOrder, Count > 0 marks a leaf. The left child of an inner node is always the next node. */
+		int32 Start = 0;
+		int32 Count = 0;
+		int32 RightChild = INDEX_NONE;
+	};
+
+	static constexpr int32 MaxLeafSegments = 4;
+
+	int32 BuildNode(int32 Start, int32 Count, const TArray<FVector>& Centroids);
+
+	TArray<FVector> Points;
+	TArray<float> InputKeys;
+	TArray<float> Distances;
+
+	TArray<int32> SegmentOrder;
+	TArray<FNode> Nodes;
+
+	int32 SamplesPerSplineSegment = 1;
+	int32 NumSplineSegments = 0;
+	bool bClosedLoop = false;
+};
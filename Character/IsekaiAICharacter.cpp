@@ -4,12 +4,17 @@
 #include "IsekaiAICharacter.h"
 
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/NativeGameplayTags.h"
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySet.h"
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
 #include "AIAssessment/AbilitySystem/IsekaiAttributeSet.h"
 #include "AIAssessment/AI/IsekaiAIController.h"
+#include "AIAssessment/Character/IsekaiCharacterMovementComponent.h"
 #include "AIAssessment/Component/AIStealthComponent.h"
+#include "AIAssessment/Subsystem/World/AIPatrolProxySubsystem.h"
+#include "AIAssessment/Subsystem/World/AIPoolSubsystem.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIAssessment/Widget/AIOverheadWidget.h"
@@ -67,6 +72,19 @@ void AIsekaiAICharacter::Tick(float DeltaTime)
 	}
 }
 
+void AIsekaiAICharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	
+	// Pool spawns arrive with the classes loaded, level-placed AI start loading here, ahead of BeginPlay
+	const UWorld* World = GetWorld();
+	if (HasAuthority() && World && World->IsGameWorld() && !bStartupDataApplied)
+	{
+		StartupAbilitySetsLoadHandle = UIsekaiAbilitySet::LoadAbilitySetsAsync(StartupAbilitySets,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleStartupAbilitySetsLoaded));
+	}
+}
+
 void AIsekaiAICharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -119,17 +137,44 @@ void AIsekaiAICharacter::ApplyStartupData()
 		return;
 	}
 	
-	for (const UIsekaiAbilitySet* AbilitySet : StartupAbilitySets)
+	// Level streaming can begin play before the preload is done, grant once it completes instead of loading synchronously
+	if (StartupAbilitySetsLoadHandle.IsValid() && StartupAbilitySetsLoadHandle->IsLoadingInProgress())
 	{
-		if (AbilitySet)
-		{
-			AbilitySet->GiveToAbilitySystem(IsekaiAbilitySystemComponent, nullptr, this);
-		}
+		bStartupDataGrantPending = true;
+		return;
 	}
 	
+	UIsekaiAbilitySet::GiveAbilitySetsToAbilitySystem(StartupAbilitySets, IsekaiAbilitySystemComponent, &StartupAbilitySetHandles, this);
+	StartupAbilitySetsLoadHandle.Reset();
+	
 	bStartupDataApplied = true;
 }
 
+void AIsekaiAICharacter::HandleStartupAbilitySetsLoaded()
+{
+	StartupAbilitySetsLoadHandle.Reset();
+	
+	if (bStartupDataGrantPending)
+	{
+		bStartupDataGrantPending = false;
+		ApplyStartupData();
+	}
+}
+
+
+void AIsekaiAICharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+	
+	// Only patrolling AI handed out by the pool can be represented by a proxy
+	if (bAllowPatrolProxy && bSpawnedFromPool && !PatrolPath.IsNull())
+	{
+		if (UAIPatrolProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UAIPatrolProxySubsystem>())
+		{
+			ProxySubsystem->TrackAI(this);
+		}
+	}
+}
 
 void AIsekaiAICharacter::HandleOutOfHealth()
 {
@@ -142,12 +187,154 @@ void AIsekaiAICharacter::HandleOutOfHealth()
 		StealthComponent->Reset();
 	}
 	
+	const UAIPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAIPoolSubsystem>();
+	const bool bUsePool = PoolSubsystem && PoolSubsystem->IsPoolingEnabled();
+	
+	if (AIsekaiAIController* AIController = Cast<AIsekaiAIController>(GetController()))
+	{
+		AIController->HandlePawnDeath(!bUsePool);
+	}
+	
+	if (bUsePool)
+	{
+		// Keep the corpse around for the same time, then recycle instead of destroying
+		GetWorldTimerManager().SetTimer(PoolReleaseTimerHandle, this, &ThisClass::ReleaseToPool, FMath::Max(DestructionDelayAfterDeath, UE_KINDA_SMALL_NUMBER), false);
+	}
+	else
+	{
+		SetLifeSpan(DestructionDelayAfterDeath);
+	}
+}
+
+void AIsekaiAICharacter::ReleaseToPool()
+{
+	UAIPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAIPoolSubsystem>();
+	if (!PoolSubsystem || !PoolSubsystem->ReleaseAI(this))
+	{
+		// Pool is full or disabled, fall back to the regular destruction path
+		if (AController* DeadController = GetController())
+		{
+			DeadController->Destroy();
+		}
+		Destroy();
+	}
+}
+
+EVisibilityBasedAnimTickOption AIsekaiAICharacter::GetDefaultAnimTickOption() const
+{
+	const USkeletalMeshComponent* DefaultMesh = GetClass()->GetDefaultObject<AIsekaiAICharacter>()->GetMesh();
+	return DefaultMesh ? DefaultMesh->VisibilityBasedAnimTickOption : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+}
+
+void AIsekaiAICharacter::ApplySpawnParams(const FIsekaiAISpawnParams& Params)
+{
+	bSpawnedFromPool = true;
+	PatrolPath = Params.PatrolPath;
+	
+	if (SquadComponent && Params.SquadID != INDEX_NONE)
+	{
+		SquadComponent->SetSquadID(Params.SquadID);
+	}
+}
+
+void AIsekaiAICharacter::DeactivateForPool()
+{
+	if (!HasAuthority()) return;
+	
+	GetWorldTimerManager().ClearTimer(PoolReleaseTimerHandle);
+	
 	if (AIsekaiAIController* AIController = Cast<AIsekaiAIController>(GetController()))
 	{
-		AIController->HandlePawnDeath();
+		// Idempotent, a dead pawn already went through this in HandleOutOfHealth
+		AIController->HandlePawnDeath(false);
+		PooledController = AIController;
+		AIController->UnPossess();
+	}
+	
+	if (StealthComponent)
+	{
+		StealthComponent->Reset();
+	}
+	if (SquadComponent)
+	{
+		SquadComponent->LeaveSquad();
+	}
+	
+	if (UIsekaiCharacterMovementComponent* MoveComp = GetIsekaiCharacterMovement())
+	{
+		// Profiles from the previous life's behavior tree must not leak into the next one
+		MoveComp->ClearMovementProfiles();
+		MoveComp->StopMovementImmediately();
+		MoveComp->DisableMovement();
 	}
 	
-	SetLifeSpan(DestructionDelayAfterDeath);
+	// The next life starts from the authored option, whatever tier the previous one ended in
+	if (USkeletalMeshComponent* SkeletalMesh = GetMesh())
+	{
+		SkeletalMesh->VisibilityBasedAnimTickOption = GetDefaultAnimTickOption();
+	}
+	
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	
+	// Replicates the hidden state, then stops replicating until reactivated
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AIsekaiAICharacter::ActivateFromPool(const FTransform& Transform, const FIsekaiAISpawnParams& Params)
+{
+	if (!HasAuthority()) return;
+	
+	SetNetDormancy(DORM_Awake);
+	
+	ApplySpawnParams(Params);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	
+	ResetAbilitySystemForReuse();
+	
+	// Clears bIsDead and restores movement/collision on server and clients
+	HandleRevive();
+	
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	
+	if (AIsekaiAIController* AIController = PooledController.Get())
+	{
+		AIController->Possess(this);
+	}
+	else
+	{
+		SpawnDefaultController();
+	}
+	PooledController.Reset();
+	
+	ForceNetUpdate();
+}
+
+void AIsekaiAICharacter::ResetAbilitySystemForReuse()
+{
+	if (!IsekaiAbilitySystemComponent || !IsekaiAttributeSet) return;
+	
+	IsekaiAbilitySystemComponent->CancelAllAbilities();
+	
+	// Drop everything from the previous life, including the Dead and Exhausted states
+	StartupAbilitySetHandles.RemoveEffectsFromAbilitySystem(IsekaiAbilitySystemComponent);
+	IsekaiAbilitySystemComponent->RemoveActiveEffects(FGameplayEffectQuery());
+	IsekaiAbilitySystemComponent->ClearCharacterStates();
+	
+	// Abilities are still granted through the handles, only the startup effects are applied again
+	UIsekaiAbilitySet::GiveAbilitySetsToAbilitySystem(StartupAbilitySets, IsekaiAbilitySystemComponent, &StartupAbilitySetHandles, this);
+	
+	// Startup effects normally restore attributes, fall back to a direct reset like player respawns do
+	if (IsekaiAttributeSet->GetHealth() <= 0.f)
+	{
+		IsekaiAttributeSet->SetHealth(IsekaiAttributeSet->GetMaxHealth());
+		IsekaiAttributeSet->SetStamina(IsekaiAttributeSet->GetMaxStamina());
+	}
+	
+	IsekaiAbilitySystemComponent->ForceReplication();
 }
 
 void AIsekaiAICharacter::HandleVisualsOnDeath()
@@ -159,3 +346,13 @@ void AIsekaiAICharacter::HandleVisualsOnDeath()
 		WidgetComponent->SetVisibility(false);
 	}
 }
+
+void AIsekaiAICharacter::HandleVisualsOnRevive()
+{
+	Super::HandleVisualsOnRevive();
+	
+	if (WidgetComponent)
+	{
+		WidgetComponent->SetVisibility(true);
+	}
+}
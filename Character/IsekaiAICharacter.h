@@ -5,14 +5,19 @@
 #include "CoreMinimal.h"
 #include "IsekaiCharacterBase.h"
 #include "AIAssessment/AI/IsekaiAITypes.h"
+#include "AIAssessment/AbilitySystem/IsekaiAbilitySet.h"
 #include "AIAssessment/Component/AISquadComponent.h"
+#include "Components/SkinnedMeshComponent.h"
 #include "IsekaiAICharacter.generated.h"
 
+class AIsekaiAIController;
 class AIsekaiPatrolPath;
+struct FIsekaiAISpawnParams;
 class UAIOverheadWidget;
 class UWidgetComponent;
 class UBehaviorTree;
 class UIsekaiAbilitySet;
+class UIsekaiPerceptionProfile;
 
 /**
  * Isekai AI Character base class.
@@ -34,23 +39,44 @@ public:
 	FAlertTuning GetAlertTuning() const { return AlertTuning; }
 	UAIStealthComponent* GetStealthComponent() const { return StealthComponent; }
 	TSoftObjectPtr<AIsekaiPatrolPath> GetPatrolPath() const { return PatrolPath; }
+	const UIsekaiPerceptionProfile* GetPerceptionProfile() const { return PerceptionProfile; }
+	TConstArrayView<TObjectPtr<UIsekaiAbilitySet>> GetStartupAbilitySets() const { return StartupAbilitySets; }
+	/** Anim tick option the mesh is authored with, read from the class defaults since significance tiers lower it at runtime. */
+	EVisibilityBasedAnimTickOption GetDefaultAnimTickOption() const;
 	
 	// --- Overrides ---
 	virtual void HandleOutOfHealth() override;
 	
+	// --- Pooling (Server Only) ---
+	/** Applies per-spawn data. Before BeginPlay it only stores it, afterwards it takes effect immediately. */
+	void ApplySpawnParams(const FIsekaiAISpawnParams& Params);
+	/** Shuts down the controller, resets AI state and hides the pawn. The controller is kept for reuse. */
+	void DeactivateForPool();
+	/** Resets GAS state, revives, moves the pawn to Transform and re-possesses it. */
+	void ActivateFromPool(const FTransform& Transform, const FIsekaiAISpawnParams& Params);
+	
 	UFUNCTION(BlueprintPure, Category="Isekai|AI|Squad")
 	int32 GetSquadID() const { return SquadComponent ? SquadComponent->GetSquadID() : INDEX_NONE; }
 
 protected:
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void PossessedBy(AController* NewController) override;
 	
 	virtual void HandleVisualsOnDeath() override;
+	virtual void HandleVisualsOnRevive() override;
 	
 	/** Safe entry point to initialize the Overhead UI Widget */
 	void InitOverheadWidget();
 	
-	/** Grants default attributes and ability sets to the AI */
+	/** Grants default attributes and ability sets to the AI. Deferred until the sets' preload completes if it is still running. */
 	void ApplyStartupData();
+	void HandleStartupAbilitySetsLoaded();
+	
+	/** Clears abilities, effects and death state, then re-applies the startup sets through the existing handles. */
+	void ResetAbilitySystemForReuse();
+	
+	void ReleaseToPool();
 	
 	// --- Components ---
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Isekai|AIConfig")
@@ -67,13 +93,37 @@ protected:
 	float DestructionDelayAfterDeath = 5.f;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Isekai")
 	FAlertTuning AlertTuning;
+	/** Sense ranges and processing rate for this archetype. Null uses the profile defaults. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Isekai|AIConfig")
+	TObjectPtr<UIsekaiPerceptionProfile> PerceptionProfile;
 	
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category="Isekai")
 	TSoftObjectPtr<AIsekaiPatrolPath> PatrolPath;
 	
+	/**
+	 * Allow this AI to be replaced by a lightweight patrol proxy while idle and far from every player.
+	 * Only applies to pool-spawned AI, a proxy comes back as whichever pooled instance is free and keeps only path and squad.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Isekai|AIConfig")
+	bool bAllowPatrolProxy = false;
+	
 	// --- GAS Config ---
 	UPROPERTY(EditDefaultsOnly, Category="Isekai|GAS")
 	TArray<TObjectPtr<UIsekaiAbilitySet>> StartupAbilitySets;
 	
+	/** Handles for the startup sets, reused when the AI comes back from the pool. */
+	FIsekaiAbilitySetGrantedHandles StartupAbilitySetHandles;
+	
+	/** Preload of the startup sets' soft classes for AI that were not spawned through the pool, e.g. level-placed ones. */
+	TSharedPtr<FStreamableHandle> StartupAbilitySetsLoadHandle;
+	
+	/** Controller parked with the pawn while it is pooled. */
+	TWeakObjectPtr<AIsekaiAIController> PooledController;
+	FTimerHandle PoolReleaseTimerHandle;
+	
 	uint8 bStartupDataApplied : 1;
+	/** Set by ApplySpawnParams, level-placed AI carry per-instance edits a proxy round trip would lose. */
+	uint8 bSpawnedFromPool : 1;
+	/** BeginPlay asked for the startup data before the preload finished, it is granted when it does. */
+	uint8 bStartupDataGrantPending : 1;
 };
@@ -9,9 +9,11 @@
 #include "AIAssessment/IsekaiLoggingChannels.h"
 #include "IsekaiCharacterMovementComponent.h"
 #include "AIAssessment/AI/Utility/AIUtility.h"
+#include "AIAssessment/Subsystem/World/IsekaiRegenSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Perception/AIPerceptionSystem.h"
+#include "Perception/AISense_Sight.h"
 
 AIsekaiCharacterBase::AIsekaiCharacterBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UIsekaiCharacterMovementComponent>(CharacterMovementComponentName))
@@ -59,7 +61,6 @@ FGenericTeamId AIsekaiCharacterBase::GetGenericTeamId() const
 ETeamAttitude::Type AIsekaiCharacterBase::GetTeamAttitudeTowards(const AActor& Other) const
 {
 	return FAIUtility::GetTeamAttitude(this, &Other);
-	// return FAIUtility::GetTeamAttitude(this, &Other);
 }
 
 float AIsekaiCharacterBase::GetHealth() const
@@ -74,7 +75,7 @@ float AIsekaiCharacterBase::GetMaxHealth() const
 
 float AIsekaiCharacterBase::GetStamina() const
 {
-	return IsekaiAttributeSet ? IsekaiAttributeSet->GetStamina() : 0.0f;
+	return IsekaiAttributeSet ? IsekaiAttributeSet->GetCurrentStamina() : 0.0f;
 }
 
 float AIsekaiCharacterBase::GetMaxStamina() const
@@ -105,6 +106,16 @@ void AIsekaiCharacterBase::InitAbilitySystem(AActor* Owner, UIsekaiAbilitySystem
 	UIBridge->InitAbilitySystem(IsekaiAbilitySystemComponent, IsekaiAttributeSet);
 	
 	GetIsekaiCharacterMovement()->InitializeIsekaiReferences(this, IsekaiAbilitySystemComponent);
+	
+	// Regen and drain are integrated server-side in one batched pass when the project opts in, periodic effects do it otherwise.
+	// Registering again (e.g. on possession) is a no-op
+	if (HasAuthority() && UIsekaiRegenSubsystem::IsIntegrationEnabled())
+	{
+		if (UIsekaiRegenSubsystem* RegenSubsystem = GetWorld()->GetSubsystem<UIsekaiRegenSubsystem>())
+		{
+			RegenSubsystem->RegisterASC(IsekaiAbilitySystemComponent, IsekaiAttributeSet);
+		}
+	}
 }
 
 
@@ -139,10 +150,29 @@ void AIsekaiCharacterBase::HandleOutOfHealth()
 	// Player and AI handling (e.g., respawn, destroy) should be done in subclasses
 }
 
+void AIsekaiCharacterBase::HandleRevive()
+{
+	if (!bIsDead || !HasAuthority())
+	{
+		return;
+	}
+	
+	bIsDead = false; // Triggers OnRep_IsDead on clients
+	
+	// Undo the unregister from HandleOutOfHealth, sight is the only sense that needs registered sources
+	if (UAIPerceptionSystem* PerceptionSys = UAIPerceptionSystem::GetCurrent(GetWorld()))
+	{
+		PerceptionSys->RegisterSourceForSenseClass(UAISense_Sight::StaticClass(), *this);
+	}
+	
+	HandleVisualsOnRevive();
+}
+
 void AIsekaiCharacterBase::OnRep_IsDead()
 {
 	if (!bIsDead)
 	{
+		HandleVisualsOnRevive();
 		return;
 	}
 	
@@ -173,3 +203,18 @@ void AIsekaiCharacterBase::HandleVisualsOnDeath()
 
 	BP_OnDeath();
 }
+
+void AIsekaiCharacterBase::HandleVisualsOnRevive()
+{
+	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	{
+		MoveComp->SetMovementMode(MOVE_Walking);
+	}
+	
+	if (UCapsuleComponent* CapsuleComp = GetCapsuleComponent())
+	{
+		CapsuleComp->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	}
+	
+	BP_OnRevive();
+}
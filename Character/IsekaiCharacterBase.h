@@ -41,6 +41,8 @@ public:
 	virtual void SetGenericTeamId(const FGenericTeamId& TeamID) override;
 	virtual FGenericTeamId GetGenericTeamId() const override;
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
+	/** Non-virtual read of the team ID for hot attitude checks. */
+	FORCEINLINE FGenericTeamId GetCachedTeamId() const { return TeamIdStruct; }
 	
 	/**
 	 * Server-authoritative death entry point.
@@ -48,6 +50,9 @@ public:
 	 */
 	virtual void HandleOutOfHealth();
 	
+	/** Server-only. Leaves the death state so the character can be reused, e.g. by the AI pool. */
+	virtual void HandleRevive();
+	
 	// Attribute Helper
 	UFUNCTION(BlueprintPure, Category="Isekai|Attributes")
 	float GetHealth() const;
@@ -62,6 +67,8 @@ public:
 	
 	UFUNCTION(BlueprintImplementableEvent, Category="Isekai|Attributes")
 	void BP_OnDeath();
+	UFUNCTION(BlueprintImplementableEvent, Category="Isekai|Attributes")
+	void BP_OnRevive();
 protected:
 	virtual void BeginPlay() override;
 	/**
@@ -72,6 +79,8 @@ protected:
 
 	/** Called on server and clients when death state is entered to apply local visuals/physics. */
 	virtual void HandleVisualsOnDeath();
+	/** Called on server and clients when death state is left, undoing HandleVisualsOnDeath. */
+	virtual void HandleVisualsOnRevive();
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TObjectPtr<UIsekaiUIBridge> UIBridge;
@@ -88,7 +97,7 @@ protected:
 	UPROPERTY(ReplicatedUsing=OnRep_IsDead)
 	bool bIsDead = false;
 	
-	/** Replication hook for bIsDead. Triggers local death visuals. */
+	/** Replication hook for bIsDead. Triggers local death or revive visuals. */
 	UFUNCTION()
 	void OnRep_IsDead();
 	UFUNCTION()
@@ -5,6 +5,7 @@
 
 #include "IsekaiCharacterBase.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
 #include "AIAssessment/NativeGameplayTags.h"
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -38,6 +39,16 @@ void UIsekaiCharacterMovementComponent::InitializeIsekaiReferences(AIsekaiCharac
 			this, &UIsekaiCharacterMovementComponent::HandleExhaustedTagChanged);
 }
 
+void UIsekaiCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	bDefaultOrientRotationToMovement = bOrientRotationToMovement;
+	bDefaultUseControllerDesiredRotation = bUseControllerDesiredRotation;
+	
+	ResolveMovementProfiles();
+}
+
 void UIsekaiCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	if (CachedASC && ExhaustedTagChangedHandle.IsValid())
@@ -53,7 +64,7 @@ void UIsekaiCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPl
 // --- Core movement overrides ---
 float UIsekaiCharacterMovementComponent::GetMaxSpeed() const
 {
-	float Speed = Super::GetMaxSpeed();
+	const float Speed = Super::GetMaxSpeed();
 	
 	if (Speed <= 0.f || IsCrouching())
 	{
@@ -61,24 +72,33 @@ float UIsekaiCharacterMovementComponent::GetMaxSpeed() const
 		return Speed;
 	}
 	
+	// Scale relative to walk speed so non-walking modes keep their own base
 	const float NormalizedFactor = MaxWalkSpeed > 0.f ? Speed / MaxWalkSpeed : 1.f;
+	const float BaseSpeed = ResolvedSpeedOverride >= 0.f ? ResolvedSpeedOverride : MaxWalkSpeed;
 	
-	float EffectiveSpeed = MaxWalkSpeed;
+	return BaseSpeed * ResolvedSpeedMultiplier * NormalizedFactor;
+}
+
+float UIsekaiCharacterMovementComponent::GetSprintSpeed() const
+{
+	const float BaseSpeed = ResolvedSpeedOverride >= 0.f ? ResolvedSpeedOverride : MaxWalkSpeed;
 	
-	const bool bCanApplySprint = bWantsToSprint && !bIsExhausted;
-	if (bCanApplySprint)
-	{
-		EffectiveSpeed *= SprintSpeedMultiplier;
-	}
+	// Same built-in modifiers as ResolveMovementProfiles with sprint requested, exhaustion replaces the sprint bonus
+	const float BuiltInMultiplier = bIsExhausted ? ExhaustedSpeedMultiplier : SprintSpeedMultiplier;
 	
-	if (bIsExhausted)
+	return BaseSpeed * ResolvedProfileSpeedMultiplier * BuiltInMultiplier;
+}
+
+void UIsekaiCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	// Resolve before Super so this frame's movement already uses the new profile
+	if (bMovementProfilesDirty)
 	{
-		EffectiveSpeed *= ExhaustedSpeedMultiplier;
+		ResolveMovementProfiles();
 	}
 	
-	EffectiveSpeed *= NormalizedFactor;
-	
-	return EffectiveSpeed;
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
 void UIsekaiCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation,
@@ -219,14 +239,116 @@ void UIsekaiCharacterMovementComponent::StartSprinting()
 {
 	// We could check against tags etc here
 	bWantsToSprint = true;
+	
+	// Sprint start is predicted, apply the speed right away instead of waiting for the next tick
+	ResolveMovementProfiles();
 }
 
 void UIsekaiCharacterMovementComponent::StopSprinting()
 {
 	bWantsToSprint = false;
+	ResolveMovementProfiles();
 }
 
 void UIsekaiCharacterMovementComponent::SetIsExhausted(bool bNewExhausted)
 {
 	bIsExhausted = bNewExhausted;
+	ResolveMovementProfiles();
+}
+
+
+// --- Movement profiles ---
+int32 UIsekaiCharacterMovementComponent::PushMovementProfile(const FIsekaiMovementProfile& Profile)
+{
+	const int32 Handle = NextProfileHandle++;
+	ActiveProfiles.Add({ Handle, Profile });
+	MarkMovementProfilesDirty();
+	
+	return Handle;
+}
+
+void UIsekaiCharacterMovementComponent::PopMovementProfile(const int32 ProfileHandle)
+{
+	// Keep push order intact, it breaks priority ties
+	const int32 NumRemoved = ActiveProfiles.RemoveAll([ProfileHandle](const FActiveMovementProfile& Entry)
+	{
+		return Entry.Handle == ProfileHandle;
+	});
+	
+	if (NumRemoved > 0)
+	{
+		MarkMovementProfilesDirty();
+	}
+}
+
+void UIsekaiCharacterMovementComponent::ClearMovementProfiles()
+{
+	ActiveProfiles.Reset();
+	MarkMovementProfilesDirty();
+}
+
+void UIsekaiCharacterMovementComponent::ResolveMovementProfiles()
+{
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_MovementProfiles);
+	
+	bMovementProfilesDirty = false;
+	
+	float SpeedOverride = -1.f;
+	float SpeedMultiplier = 1.f;
+	EIsekaiRotationMode RotationMode = EIsekaiRotationMode::Unchanged;
+	int32 SpeedPriority = MIN_int32;
+	int32 RotationPriority = MIN_int32;
+	
+	for (const FActiveMovementProfile& Entry : ActiveProfiles)
+	{
+		const FIsekaiMovementProfile& Profile = Entry.Profile;
+		
+		SpeedMultiplier *= Profile.SpeedMultiplier;
+		
+		if (Profile.MaxWalkSpeedOverride >= 0.f && Profile.Priority >= SpeedPriority)
+		{
+			SpeedOverride = Profile.MaxWalkSpeedOverride;
+			SpeedPriority = Profile.Priority;
+		}
+		
+		if (Profile.RotationMode != EIsekaiRotationMode::Unchanged && Profile.Priority >= RotationPriority)
+		{
+			RotationMode = Profile.RotationMode;
+			RotationPriority = Profile.Priority;
+		}
+	}
+	
+	ResolvedProfileSpeedMultiplier = SpeedMultiplier;
+	
+	// Built-in modifiers
+	if (bWantsToSprint && !bIsExhausted)
+	{
+		SpeedMultiplier *= SprintSpeedMultiplier;
+	}
+	
+	if (bIsExhausted)
+	{
+		SpeedMultiplier *= ExhaustedSpeedMultiplier;
+	}
+	
+	ResolvedSpeedOverride = SpeedOverride;
+	ResolvedSpeedMultiplier = SpeedMultiplier;
+	
+	// Only write the rotation flags when they actually change
+	bool bNewOrientToMovement = bDefaultOrientRotationToMovement;
+	bool bNewUseDesiredRotation = bDefaultUseControllerDesiredRotation;
+	if (RotationMode != EIsekaiRotationMode::Unchanged)
+	{
+		bNewOrientToMovement = RotationMode == EIsekaiRotationMode::OrientToMovement;
+		bNewUseDesiredRotation = RotationMode == EIsekaiRotationMode::ControllerDesired;
+	}
+	
+	if (bOrientRotationToMovement != bNewOrientToMovement)
+	{
+		bOrientRotationToMovement = bNewOrientToMovement;
+	}
+	if (bUseControllerDesiredRotation != bNewUseDesiredRotation)
+	{
+		bUseControllerDesiredRotation = bNewUseDesiredRotation;
+	}
 }
\ No newline at end of file
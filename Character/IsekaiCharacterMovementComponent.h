@@ -13,6 +13,32 @@ class AIsekaiCharacterBase;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnIsMovingChangedSignature, bool bIsMoving);
 
+/** Rotation mode requested by a movement profile. */
+enum class EIsekaiRotationMode : uint8
+{
+	/** Profile does not care, lower priority profiles or the component defaults decide. */
+	Unchanged,
+	/** Face the direction of travel. */
+	OrientToMovement,
+	/** Follow the controller desired rotation (strafing). */
+	ControllerDesired
+};
+
+/** A prioritized request for movement speed and rotation, pushed by BT services or abilities. */
+struct FIsekaiMovementProfile
+{
+	/** Higher priority wins for speed override and rotation mode. Ties go to the most recently pushed profile. */
+	int32 Priority = 0;
+	
+	/** Replaces MaxWalkSpeed as the base speed when >= 0. */
+	float MaxWalkSpeedOverride = -1.f;
+	
+	/** Multiplier stacked with every other active profile, regardless of priority. */
+	float SpeedMultiplier = 1.f;
+	
+	EIsekaiRotationMode RotationMode = EIsekaiRotationMode::Unchanged;
+};
+
 /**
  * Custom CharacterMovementComponent for Isekai characters.
  *
@@ -45,19 +71,29 @@ public:
 	void SetIsExhausted(bool bNewExhausted);
 
 	bool IsExhausted() const { return bIsExhausted; }
+	
+	// === Movement profiles ===
+	
+	/** Adds a profile to the arbiter. Returns a handle for PopMovementProfile. Takes effect on the next resolve. */
+	int32 PushMovementProfile(const FIsekaiMovementProfile& Profile);
+	
+	/** Removes a previously pushed profile. Unknown handles are ignored. */
+	void PopMovementProfile(int32 ProfileHandle);
+	
+	/** Drops every pushed profile and restores the default rotation mode. */
+	void ClearMovementProfiles();
 
 	// === UMovementComponent / UCharacterMovementComponent ===
 	
-	/** Combines base walk speed with sprint/exhausted modifiers and root motion. */
+	/** Applies the resolved profile speed to the current movement mode. Does no multiplier math itself. */
 	virtual float GetMaxSpeed() const override;
 	
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	
 	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
 	
-	/** Convenience accessor for the current sprint speed (BaseWalkSpeed * SprintSpeedMultiplier). */
-	float GetSprintSpeed() const
-	{
-		return MaxWalkSpeed * SprintSpeedMultiplier;
-	}
+	/** Walking speed the arbiter resolves while sprinting: the winning profile override (or MaxWalkSpeed) with every multiplier applied. */
+	float GetSprintSpeed() const;
 	
 	/** True if current velocity exceeds MovingThreshold. */
 	bool IsMoving() const { return bIsMoving; }
@@ -70,8 +106,13 @@ public:
 	
 protected:
 	virtual void AddInputVector(FVector WorldVector, bool bForce = false) override;
+	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
+	/** Recomputes the cached speed and applies the winning rotation mode. Runs at most once per frame. */
+	void ResolveMovementProfiles();
+	void MarkMovementProfilesDirty() { bMovementProfilesDirty = true; }
+	
 	bool IsRootMotionActive() const;
 	
 	// === Configurable base numbers ===
@@ -111,4 +152,29 @@ protected:
 	
 	FDelegateHandle ExhaustedTagChangedHandle;
 	void HandleExhaustedTagChanged(const FGameplayTag Tag, int32 NewCount);
+	
+private:
+	// === Movement profile arbiter ===
+	
+	struct FActiveMovementProfile
+	{
+		int32 Handle = INDEX_NONE;
+		FIsekaiMovementProfile Profile;
+	};
+	
+	/** Kept in push order, so later entries win priority ties. */
+	TArray<FActiveMovementProfile, TInlineAllocator<4>> ActiveProfiles;
+	int32 NextProfileHandle = 0;
+	
+	bool bMovementProfilesDirty = true;
+	
+	/** Resolved values read by GetMaxSpeed. A negative override means "use MaxWalkSpeed". */
+	float ResolvedSpeedOverride = -1.f;
+	float ResolvedSpeedMultiplier = 1.f;
+	/** Product of the pushed profile multipliers only, without the sprint and exhaustion modifiers. */
+	float ResolvedProfileSpeedMultiplier = 1.f;
+	
+	/** Rotation flags captured at BeginPlay, restored when no profile requests a rotation mode. */
+	bool bDefaultOrientRotationToMovement = false;
+	bool bDefaultUseControllerDesiredRotation = false;
 };
@@ -22,26 +22,26 @@ void UAISquadComponent::BeginPlay()
 	if (GetSquadSubsystem())
 	{
 		GetSquadSubsystem()->RegisterMember(SquadID, this);
+		bRegistered = true;
 	}
 }
 
 void UAISquadComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (GetSquadSubsystem())
-	{
-		GetSquadSubsystem()->UnregisterMember(SquadID, this);
-	}
+	LeaveSquad();
 	
 	Super::EndPlay(EndPlayReason);
 }
 
 void UAISquadComponent::SetSquadID(const int32 NewSquadID)
 {
-	if (GetSquadSubsystem())
+	// Before BeginPlay the ID is only stored, BeginPlay does the registration
+	if (HasBegunPlay() && GetSquadSubsystem())
 	{
-		GetSquadSubsystem()->UnregisterMember(SquadID, this);
+		LeaveSquad();
 		SquadID = NewSquadID;
 		GetSquadSubsystem()->RegisterMember(SquadID, this);
+		bRegistered = true;
 	}
 	else
 	{
@@ -49,6 +49,15 @@ void UAISquadComponent::SetSquadID(const int32 NewSquadID)
 	}
 }
 
+void UAISquadComponent::LeaveSquad()
+{
+	if (bRegistered && GetSquadSubsystem())
+	{
+		GetSquadSubsystem()->UnregisterMember(SquadID, this);
+	}
+	bRegistered = false;
+}
+
 
 void UAISquadComponent::BroadcastEnemySpotted(AActor* EnemyActor)
 {
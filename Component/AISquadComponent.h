@@ -26,6 +26,8 @@ public:
 	
 	int32 GetSquadID() const { return SquadID; }
 	void SetSquadID(const int32 NewSquadID);
+	/** Stops receiving squad messages until SetSquadID is called again. */
+	void LeaveSquad();
 
 protected:
 	virtual void BeginPlay() override;
@@ -41,4 +43,5 @@ protected:
 private:
 	UAISquadSubsystem* GetSquadSubsystem();
 	TWeakObjectPtr<UAISquadSubsystem> CachedSquadSubsystem;
+	bool bRegistered = false;
 };
@@ -6,6 +6,8 @@
 #include "AbilitySystemComponent.h"
 #include "AIController.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
+#include "AIAssessment/Development/IsekaiTelemetry.h"
 #include "AIAssessment/AI/IsekaiBlackboardKeys.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Net/UnrealNetwork.h"
@@ -102,6 +104,27 @@ void UAIStealthComponent::Reset()
 	Tuning = FAlertTuning();
 }
 
+void UAIStealthComponent::SeedAlertValue(const float InAlertValue)
+{
+	if (!GetOwner()->HasAuthority() || !IsValid(BlackboardComp)) return;
+	
+	const float SeededValue = FMath::Clamp(InAlertValue, 0.f, FMath::Max(Tuning.SuspiciousThreshold - UE_KINDA_SMALL_NUMBER, 0.f));
+	if (SeededValue <= 0.f) return;
+	
+	// Skip the grace period, the stimulus that raised the alert is long gone
+	TimeSinceLastStimulus = Tuning.GraceTime;
+	
+	EvaluateStateTransition(SeededValue);
+	
+	// Run the update loop so the seeded alert decays normally
+	GetWorld()->GetTimerManager().SetTimer(
+		AlertTimerHandle,
+		this,
+		&UAIStealthComponent::UpdateAlertLogic,
+		TIMER_RATE,
+		true);
+}
+
 void UAIStealthComponent::CompleteSearch()
 {
 	if (!GetOwner()->HasAuthority()) return;
@@ -130,8 +153,12 @@ void UAIStealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void UAIStealthComponent::HandleSightStimulus(AActor* SightActor, const FAIStimulus& Stimulus)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_StealthStimulus);
+	
 	if (!GetOwner()->HasAuthority() || !IsValid(BlackboardComp))	return;
 	
+	ISEKAI_INC_COUNTER(STAT_Isekai_StimuliProcessed, 1);
+	
 	const bool bIsSensed = Stimulus.WasSuccessfullySensed();
 	
 	// Update blackboard awareness
@@ -170,11 +197,15 @@ void UAIStealthComponent::HandleSightStimulus(AActor* SightActor, const FAIStimu
 
 void UAIStealthComponent::HandleHearingStimulus(AActor* HearingActor, FAIStimulus Stimulus)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_StealthStimulus);
+	
 	if (!GetOwner()->HasAuthority() || !Stimulus.WasSuccessfullySensed() || !IsValid(BlackboardComp))
 	{
 		return;
 	}
 	
+	ISEKAI_INC_COUNTER(STAT_Isekai_StimuliProcessed, 1);
+	
 	// Update blackboard awareness
 	BlackboardComp->SetValueAsVector(BBKeys::GStimulusLocation, Stimulus.StimulusLocation);
 	BlackboardComp->SetValueAsObject(BBKeys::GTargetActor, HearingActor);
@@ -204,8 +235,12 @@ void UAIStealthComponent::HandleHearingStimulus(AActor* HearingActor, FAIStimulu
 
 void UAIStealthComponent::HandleSquadStimulus(AActor* TargetActor, FVector TargetLocation, float AlertAmount)
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_StealthStimulus);
+	
 	if (!GetOwner()->HasAuthority() || !IsValid(BlackboardComp)) return;
 	
+	ISEKAI_INC_COUNTER(STAT_Isekai_StimuliProcessed, 1);
+	
 	// Update blackboard awareness
 	BlackboardComp->SetValueAsVector(BBKeys::GStimulusLocation, TargetLocation);
 	if (IsValid(TargetActor))
@@ -235,6 +270,8 @@ void UAIStealthComponent::HandleSquadStimulus(AActor* TargetActor, FVector Targe
 
 void UAIStealthComponent::UpdateAlertLogic()
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_StealthAlertUpdate);
+	
 	if (!GetOwner()->HasAuthority() || !IsValid(BlackboardComp)) return;
 
 	AActor* Target = GetTargetActor();
@@ -386,6 +423,11 @@ void UAIStealthComponent::EvaluateStateTransition(float NewVal)
 		}
 	}
 	
+	if (bStateChanged)
+	{
+		ISEKAI_TELEMETRY_EVENT(StealthTransition, GetOwner(), GetTargetActor(), NAME_None, static_cast<int32>(NewState), CurrentAlertValue);
+	}
+	
 	if (bStateChanged || bAlertChanged)
 	{
 		CurrentStealthState = NewState;
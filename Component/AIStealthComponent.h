@@ -76,6 +76,9 @@ public:
 	void Init(AAIController* AICon, UBlackboardComponent* Blackboard, const FAlertTuning& Tuning);
 	void Reset();
 	
+	/** Restores residual alert after re-hydration. Clamped below suspicion, so the AI always resumes Idle. Call after Init. */
+	void SeedAlertValue(float InAlertValue);
+	
 	UFUNCTION(BlueprintCallable, Category="Isekai|AI|Stealth")
 	void CompleteSearch();
 	
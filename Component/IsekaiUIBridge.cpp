@@ -8,10 +8,27 @@
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
 #include "AIAssessment/NativeGameplayTags.h"
 
+namespace UIBridgeCVars
+{
+	static TAutoConsoleVariable<float> CVarStaminaRebaseTolerance(
+		TEXT("Isekai.UI.StaminaRebaseTolerance"),
+		2.f,
+		TEXT("Stamina attribute updates further than this from the predicted value rebase the trajectory (costs). Closer ones are stale echoes and ignored."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<float> CVarStaminaCorrectionBlendTime(
+		TEXT("Isekai.UI.StaminaCorrectionBlendTime"),
+		0.15f,
+		TEXT("Time constant in seconds for blending out the error when a trajectory correction arrives. 0 snaps."),
+		ECVF_Default);
+}
+
 
 UIsekaiUIBridge::UIsekaiUIBridge()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Only ticks while a predicted stamina value is changing
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UIsekaiUIBridge::InitAbilitySystem(UIsekaiAbilitySystemComponent* InASC, UIsekaiAttributeSet* InAttributeSet)
@@ -63,6 +80,16 @@ void UIsekaiUIBridge::InitAbilitySystem(UIsekaiAbilitySystemComponent* InASC, UI
 	SprintingTagHandle = 
 		AbilitySystem->RegisterGameplayTagEvent(Tags::State::Movement_Sprinting)
 		.AddUObject(this, &ThisClass::HandleSprintingTagChanged);
+	
+	// Stamina Trajectory
+	
+	StaminaTrajectoryChangedHandle = 
+		AttributeSet->OnStaminaTrajectoryChanged.AddUObject(this, &ThisClass::HandleStaminaTrajectoryChanged);
+	
+	if (AttributeSet->GetStaminaTrajectory().IsValid())
+	{
+		HandleStaminaTrajectoryChanged();
+	}
 }
 
 void UIsekaiUIBridge::InitStealthComponent(UAIStealthComponent* InStealthComponent)
@@ -129,6 +156,15 @@ void UIsekaiUIBridge::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		}
 	}
 	
+	if (AttributeSet.IsValid())
+	{
+		if (StaminaTrajectoryChangedHandle.IsValid())
+		{
+			AttributeSet->OnStaminaTrajectoryChanged.Remove(StaminaTrajectoryChangedHandle);
+			StaminaTrajectoryChangedHandle.Reset();
+		}
+	}
+	
 	if (StealthComponent.IsValid())
 	{
 		if (StealthStateDataChangedHandle.IsValid())
@@ -141,6 +177,23 @@ void UIsekaiUIBridge::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
+void UIsekaiUIBridge::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	
+	if (StaminaCorrectionOffset != 0.f)
+	{
+		const float BlendTime = UIBridgeCVars::CVarStaminaCorrectionBlendTime.GetValueOnGameThread();
+		StaminaCorrectionOffset = BlendTime > 0.f ? StaminaCorrectionOffset * FMath::Exp(-DeltaTime / BlendTime) : 0.f;
+		if (FMath::Abs(StaminaCorrectionOffset) < UE_KINDA_SMALL_NUMBER)
+		{
+			StaminaCorrectionOffset = 0.f;
+		}
+	}
+	
+	RefreshPredictedStamina();
+}
+
 
 
 FString UIsekaiUIBridge::GetStealthStateAsString() const
@@ -187,6 +240,21 @@ void UIsekaiUIBridge::HandleMaxHealthChanged(const struct FOnAttributeChangeData
 
 void UIsekaiUIBridge::HandleStaminaChanged(const struct FOnAttributeChangeData& Data)
 {
+	if (StaminaTrajectory.IsValid() && AttributeSet.IsValid())
+	{
+		// Writes from the server lag the prediction, only real changes (costs, resets) move the curve
+		const float ServerTime = AttributeSet->GetServerTime();
+		const float Tolerance = UIBridgeCVars::CVarStaminaRebaseTolerance.GetValueOnGameThread();
+		if (FMath::Abs(Data.NewValue - StaminaTrajectory.Evaluate(ServerTime)) > Tolerance)
+		{
+			StaminaTrajectory.Value = Data.NewValue;
+			StaminaTrajectory.ServerTime = ServerTime;
+			StaminaCorrectionOffset = 0.f;
+		}
+		RefreshPredictedStamina();
+		return;
+	}
+	
 	if (FMath::IsNearlyEqual(CachedStamina, Data.NewValue))
 	{
 		return;
@@ -204,6 +272,7 @@ void UIsekaiUIBridge::HandleMaxStaminaChanged(const struct FOnAttributeChangeDat
 	}
 	
 	CachedMaxStamina = Data.NewValue;
+	StaminaTrajectory.Max = FMath::Min(StaminaTrajectory.Max, CachedMaxStamina);
 	BroadcastStamina();
 }
 
@@ -225,6 +294,51 @@ void UIsekaiUIBridge::HandleStealthStateDataChanged(const FStealthStateData& New
 	BroadcastStealthStateData();
 }
 
+void UIsekaiUIBridge::HandleStaminaTrajectoryChanged()
+{
+	if (!AttributeSet.IsValid())
+	{
+		return;
+	}
+	
+	const float ServerTime = AttributeSet->GetServerTime();
+	const float DisplayedStamina = StaminaTrajectory.IsValid() ? EvaluateStamina(ServerTime) : CachedStamina;
+	
+	StaminaTrajectory = AttributeSet->GetStaminaTrajectory();
+	
+	// Keep showing the old value and blend the divergence out, unless the blend is disabled
+	const float BlendTime = UIBridgeCVars::CVarStaminaCorrectionBlendTime.GetValueOnGameThread();
+	StaminaCorrectionOffset = BlendTime > 0.f ? DisplayedStamina - StaminaTrajectory.Evaluate(ServerTime) : 0.f;
+	
+	RefreshPredictedStamina();
+}
+
+// --- Stamina Prediction ---
+
+float UIsekaiUIBridge::EvaluateStamina(const float ServerTime) const
+{
+	return FMath::Clamp(StaminaTrajectory.Evaluate(ServerTime) + StaminaCorrectionOffset, 0.f, CachedMaxStamina);
+}
+
+void UIsekaiUIBridge::RefreshPredictedStamina()
+{
+	if (!StaminaTrajectory.IsValid() || !AttributeSet.IsValid())
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+	
+	const float ServerTime = AttributeSet->GetServerTime();
+	const float PredictedStamina = EvaluateStamina(ServerTime);
+	if (!FMath::IsNearlyEqual(CachedStamina, PredictedStamina))
+	{
+		CachedStamina = PredictedStamina;
+		BroadcastStamina();
+	}
+	
+	SetComponentTickEnabled(StaminaCorrectionOffset != 0.f || StaminaTrajectory.IsChanging(ServerTime));
+}
+
 // Broadcast helpers
 
 void UIsekaiUIBridge::BroadcastHealth()
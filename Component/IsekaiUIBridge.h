@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AIStealthComponent.h"
 #include "AIAssessment/AI/IsekaiAITypes.h"
+#include "AIAssessment/AbilitySystem/IsekaiAttributeSet.h"
 #include "Components/ActorComponent.h"
 #include "IsekaiUIBridge.generated.h"
 
@@ -27,6 +28,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStealthStateChangedSignature, con
  * HYBRID USAGE:
  * - On Players: InitAbilitySystem() is called. InitStealthComponent() is NOT called.
  * - On AI: Both are called.
+ * 
+ * STAMINA:
+ * When the server publishes a stamina trajectory, stamina is evaluated from it every frame while it changes instead of
+ * waiting for attribute updates. Attribute updates that diverge from the prediction (costs) rebase it, small
+ * trajectory corrections are blended out.
  */
 UCLASS(ClassGroup=(UI), meta=(BlueprintSpawnableComponent))
 class AIASSESSMENT_API UIsekaiUIBridge : public UActorComponent
@@ -92,6 +98,7 @@ public:
 	
 protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// --- Event Handlers ---
 	void HandleHealthChanged(const struct FOnAttributeChangeData& Data);
@@ -101,6 +108,12 @@ protected:
 	void HandleExhaustedTagChanged(const struct FGameplayTag Tag, int32 NewCount);
 	void HandleSprintingTagChanged(const struct FGameplayTag Tag, int32 NewCount);
 	void HandleStealthStateDataChanged(const FStealthStateData& NewData);
+	void HandleStaminaTrajectoryChanged();
+	
+	// --- Stamina Prediction ---
+	float EvaluateStamina(float ServerTime) const;
+	/** Re-evaluates the predicted stamina, broadcasts on change and ticks only while it keeps changing. */
+	void RefreshPredictedStamina();
 
 	// --- Broadcast Helpers ---
 	void BroadcastHealth();
@@ -123,6 +136,11 @@ protected:
 	bool bIsSprinting = false;
 	FStealthStateData CachedStealthStateData;
 	
+	/** Local copy of the replicated trajectory, rebased by predicted attribute changes. */
+	FIsekaiStaminaTrajectory StaminaTrajectory;
+	/** Remaining display error from the last correction, decays to zero. */
+	float StaminaCorrectionOffset = 0.f;
+	
 	// --- Delegate Handles ---
 	FDelegateHandle HealthChangedHandle;
 	FDelegateHandle MaxHealthChangedHandle;
@@ -131,4 +149,5 @@ protected:
 	FDelegateHandle ExhaustedTagHandle;
 	FDelegateHandle SprintingTagHandle;
 	FDelegateHandle StealthStateDataChangedHandle;
+	FDelegateHandle StaminaTrajectoryChangedHandle;
 };
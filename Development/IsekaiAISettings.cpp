@@ -0,0 +1,29 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiAISettings.h"
+
+#include "AIAssessment/AI/Utility/AIUtility.h"
+
+void UIsekaiAISettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+	
+	// Config is loaded by now. Every process builds this default at module load, game mode or not
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FAIUtility::InstallTeamAttitudeSolver();
+	}
+}
+
+#if WITH_EDITOR
+void UIsekaiAISettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, TeamAttitudeOverrides))
+	{
+		FAIUtility::RebuildTeamAttitudeTable();
+	}
+}
+#endif
@@ -0,0 +1,148 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "GenericTeamAgentInterface.h"
+#include "AIAssessment/AI/IsekaiAITypes.h"
+#include "IsekaiAISettings.generated.h"
+
+class AIsekaiAICharacter;
+
+/** Overrides a single entry of the team attitude table. Team IDs are raw, so factions beyond EIsekaiTeamID need no code. */
+USTRUCT()
+struct FIsekaiTeamAttitudeOverride
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, Category="Teams", meta=(ClampMin="0", ClampMax="31"))
+	uint8 TeamA = 0;
+	
+	UPROPERTY(EditAnywhere, Category="Teams", meta=(ClampMin="0", ClampMax="31"))
+	uint8 TeamB = 0;
+	
+	UPROPERTY(EditAnywhere, Category="Teams")
+	TEnumAsByte<ETeamAttitude::Type> Attitude = ETeamAttitude::Neutral;
+	
+	/** Also apply B -> A. */
+	UPROPERTY(EditAnywhere, Category="Teams")
+	bool bSymmetric = true;
+};
+
+/**
+ * Project-wide AI runtime settings.
+ */
+UCLASS(config=Game, defaultconfig, meta=(DisplayName="Isekai AI"))
+class AIASSESSMENT_API UIsekaiAISettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+public:
+	// --- Teams ---
+	/** Applied on top of the built-in attitudes (same team Friendly, Player vs Enemy Hostile, rest Neutral). */
+	UPROPERTY(EditAnywhere, Config, Category="Teams")
+	TArray<FIsekaiTeamAttitudeOverride> TeamAttitudeOverrides;
+	
+	/** The class default installs the team attitude solver, so servers and clients resolve attitudes from the same table. */
+	virtual void PostInitProperties() override;
+	
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	
+	// --- Pooling ---
+	/** Recycle dead AI pawns and controllers instead of destroying them. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Pooling")
+	bool bEnableAIPooling = true;
+	
+	/** Upper bound of inactive AI kept per class, extra releases are destroyed. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Pooling", meta=(ClampMin="0", EditCondition="bEnableAIPooling"))
+	int32 MaxPooledPerClass = 32;
+	
+	/** Number of inactive AI spawned per class when a level starts. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Pooling", meta=(EditCondition="bEnableAIPooling"))
+	TMap<TSoftClassPtr<AIsekaiAICharacter>, int32> PoolPrewarmCounts;
+	
+	// --- Significance ---
+	/** Throttle AI far away from every player. When disabled all AI stay at High significance. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance")
+	bool bEnableSignificance = true;
+	
+	/** Closer than this to any player the AI runs at full rate. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float HighSignificanceDistance = 2500.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float MediumSignificanceDistance = 6000.f;
+	
+	/** Past this the AI goes Dormant. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float LowSignificanceDistance = 12000.f;
+	
+	/** Extra distance required before demoting, so AI on a boundary don't flicker between tiers. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float SignificanceHysteresis = 500.f;
+	
+	/** Minimum time an AI stays in a tier before it may be demoted. Promotions are always immediate. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float MinTimeBeforeDemotion = 2.f;
+	
+	/** Every registered AI is re-evaluated once within this period, spread across frames. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float SignificanceUpdatePeriod = 0.5f;
+	
+	/** Minimum behavior tree tick interval per tier (High, Medium, Low, Dormant). 0 ticks whenever the tree asks to. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="s", EditFixedSize, EditCondition="bEnableSignificance"))
+	TArray<float> BrainTickIntervals = { 0.f, 0.1f, 0.25f, 1.f };
+	
+	/** Character movement tick interval for Low and Dormant AI, which also move in NavWalking mode. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Significance", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnableSignificance"))
+	float ReducedMovementTickInterval = 0.1f;
+	
+	// --- Perception ---
+	/** Listeners whose queued perception updates are processed per frame, most urgent first. 0 = unlimited. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Perception", meta=(ClampMin="0"))
+	int32 MaxPerceptionListenersPerFrame = 32;
+	
+	// --- Patrol Proxies ---
+	/**
+	 * Replace idle patrollers far from every player with lightweight proxies that only advance along their path.
+	 * Only pool-spawned AI that opt in through bAllowPatrolProxy are replaced, and only while the pool has room for them.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Patrol Proxies")
+	bool bEnablePatrolProxies = false;
+	
+	/** A proxy within this distance of any player is turned back into a full AI. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Patrol Proxies", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnablePatrolProxies"))
+	float ProxyHydrateRadius = 8000.f;
+	
+	/** An idle AI further than this from every player becomes a proxy. Keep above the hydrate radius. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Patrol Proxies", meta=(Unit="cm", ClampMin="0.0", EditCondition="bEnablePatrolProxies"))
+	float ProxyDehydrateRadius = 10000.f;
+	
+	/** How often proxies are sampled and tested against player positions. Movement itself advances every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Patrol Proxies", meta=(Unit="s", ClampMin="0.0", EditCondition="bEnablePatrolProxies"))
+	float ProxyCheckInterval = 0.25f;
+	
+	/** Caps actor activations per check so a player teleporting into a crowd doesn't hitch. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Patrol Proxies", meta=(ClampMin="1", EditCondition="bEnablePatrolProxies"))
+	int32 MaxHydrationsPerCheck = 8;
+	
+	float GetBrainTickInterval(const EIsekaiAISignificance Tier) const
+	{
+		const int32 Index = static_cast<int32>(Tier);
+		return BrainTickIntervals.IsValidIndex(Index) ? BrainTickIntervals[Index] : 0.f;
+	}
+	
+	/** Demotion distance for leaving Tier, promotion distance is the threshold itself. */
+	float GetSignificanceDistance(const EIsekaiAISignificance Tier) const
+	{
+		switch (Tier)
+		{
+		case EIsekaiAISignificance::High:	return HighSignificanceDistance;
+		case EIsekaiAISignificance::Medium:	return MediumSignificanceDistance;
+		case EIsekaiAISignificance::Low:	return LowSignificanceDistance;
+		default:							return TNumericLimits<float>::Max();
+		}
+	}
+};
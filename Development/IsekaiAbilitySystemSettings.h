@@ -0,0 +1,24 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "IsekaiAbilitySystemSettings.generated.h"
+
+/**
+ * Project-wide ability system runtime settings.
+ */
+UCLASS(config=Game, defaultconfig, meta=(DisplayName="Isekai Ability System"))
+class AIASSESSMENT_API UIsekaiAbilitySystemSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+public:
+	// --- Regen ---
+	/**
+	 * Integrate health/stamina regen and stamina drain in UIsekaiRegenSubsystem instead of periodic effects.
+	 * Remove the periodic regen effects from the startup ability sets when enabling this, characters regenerate twice otherwise.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Config, Category="Regen")
+	bool bUseRegenSubsystem = false;
+};
@@ -0,0 +1,411 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiInputLatencyTracer.h"
+
+#if ISEKAI_INPUT_LATENCY_TRACE
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace InputLatencyCVars
+{
+	static TAutoConsoleVariable<bool> CVarEnable(
+		TEXT("Isekai.InputLatency.Enable"),
+		false,
+		TEXT("Records timestamps for every ability input from the controller to the server's prediction verdict."),
+		ECVF_Default);
+}
+
+namespace
+{
+	struct FTraceEvent
+	{
+		uint64 Cycles = 0;
+		uint32 TraceId = 0;
+		EIsekaiInputLatencyStage Stage = EIsekaiInputLatencyStage::InputStarted;
+		FName Label;
+	};
+
+	/** Ring of the latest events. Written and read on the game thread only, so slots are never read mid-write. */
+	struct FTraceBuffer
+	{
+		static constexpr uint64 Capacity = 4096;
+
+		FTraceEvent Events[Capacity];
+		uint64 WriteCount = 0;
+		/** First event still considered live, moved forward by Reset. */
+		uint64 ReadStart = 0;
+	};
+
+	FTraceBuffer& GetTraceBuffer()
+	{
+		static FTraceBuffer Buffer;
+		return Buffer;
+	}
+
+	uint32 NextTraceId = 1;
+
+	void OnPredictionKeyCaughtUp(const uint32 TraceId)
+	{
+		FIsekaiInputLatencyTracer::RecordStage(TraceId, EIsekaiInputLatencyStage::Confirmed);
+	}
+
+	void OnPredictionKeyRejected(const uint32 TraceId)
+	{
+		FIsekaiInputLatencyTracer::RecordStage(TraceId, EIsekaiInputLatencyStage::Rejected);
+	}
+
+	// --- Aggregation ---
+	enum class ELatencyMetric : uint8
+	{
+		InputToProcess,
+		InputToActivate,
+		ActivateToConfirm,
+		ActivateToReject,
+		InputToResolve,
+		MAX
+	};
+
+	const TCHAR* const MetricNames[] = {
+		TEXT("InputToProcess"),
+		TEXT("InputToActivate"),
+		TEXT("ActivateToConfirm"),
+		TEXT("ActivateToReject"),
+		TEXT("InputToResolve"),
+	};
+	static_assert(UE_ARRAY_COUNT(MetricNames) == static_cast<int32>(ELatencyMetric::MAX));
+
+	/** Upper bucket edges in ms, doubling from half a millisecond. One extra open-ended bucket follows the last edge. */
+	constexpr double BucketEdgesMs[] = {0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0, 128.0, 256.0, 512.0};
+	constexpr int32 NumBuckets = UE_ARRAY_COUNT(BucketEdgesMs) + 1;
+
+	struct FLatencyHistogram
+	{
+		TArray<double> SamplesMs;
+
+		// Filled by Finalize
+		double MinMs = 0.0;
+		double P50Ms = 0.0;
+		double P95Ms = 0.0;
+		double MaxMs = 0.0;
+		double MeanMs = 0.0;
+		int32 Buckets[NumBuckets] = {};
+
+		void Finalize()
+		{
+			if (SamplesMs.IsEmpty()) return;
+
+			SamplesMs.Sort();
+			const int32 Num = SamplesMs.Num();
+			MinMs = SamplesMs[0];
+			MaxMs = SamplesMs.Last();
+			P50Ms = SamplesMs[(Num - 1) / 2];
+			P95Ms = SamplesMs[FMath::Min(Num - 1, FMath::CeilToInt32(Num * 0.95) - 1)];
+
+			double Sum = 0.0;
+			for (const double Sample : SamplesMs)
+			{
+				Sum += Sample;
+
+				int32 Bucket = 0;
+				while (Bucket < UE_ARRAY_COUNT(BucketEdgesMs) && Sample > BucketEdgesMs[Bucket])
+				{
+					++Bucket;
+				}
+				++Buckets[Bucket];
+			}
+			MeanMs = Sum / Num;
+		}
+	};
+
+	struct FAbilityLatency
+	{
+		FLatencyHistogram Metrics[static_cast<int32>(ELatencyMetric::MAX)];
+		int32 NumTraces = 0;
+		int32 NumFailed = 0;
+		int32 NumConfirmed = 0;
+		int32 NumRejected = 0;
+	};
+
+	struct FTraceTimeline
+	{
+		uint64 Cycles[static_cast<int32>(EIsekaiInputLatencyStage::MAX)] = {};
+		FName InputLabel;
+		FName AbilityLabel;
+
+		bool Has(const EIsekaiInputLatencyStage Stage) const { return Cycles[static_cast<int32>(Stage)] != 0; }
+		double DeltaMs(const EIsekaiInputLatencyStage From, const EIsekaiInputLatencyStage To) const
+		{
+			return FPlatformTime::ToMilliseconds64(Cycles[static_cast<int32>(To)] - Cycles[static_cast<int32>(From)]);
+		}
+	};
+
+	TArray<FTraceEvent> SnapshotEvents()
+	{
+		check(IsInGameThread());
+
+		const FTraceBuffer& Buffer = GetTraceBuffer();
+		const uint64 Start = FMath::Max(Buffer.ReadStart, Buffer.WriteCount > FTraceBuffer::Capacity ? Buffer.WriteCount - FTraceBuffer::Capacity : 0);
+
+		TArray<FTraceEvent> Events;
+		Events.Reserve(static_cast<int32>(Buffer.WriteCount - Start));
+		for (uint64 Index = Start; Index < Buffer.WriteCount; ++Index)
+		{
+			Events.Add(Buffer.Events[Index % FTraceBuffer::Capacity]);
+		}
+		return Events;
+	}
+
+	/** Groups events into per-trace timelines and folds them into per-ability histograms. */
+	TMap<FName, FAbilityLatency> Aggregate()
+	{
+		TMap<uint32, FTraceTimeline> Timelines;
+		for (const FTraceEvent& Event : SnapshotEvents())
+		{
+			FTraceTimeline& Timeline = Timelines.FindOrAdd(Event.TraceId);
+			uint64& StageCycles = Timeline.Cycles[static_cast<int32>(Event.Stage)];
+			if (StageCycles == 0)
+			{
+				StageCycles = Event.Cycles;
+			}
+
+			if (Event.Stage == EIsekaiInputLatencyStage::InputStarted)
+			{
+				Timeline.InputLabel = Event.Label;
+			}
+			else if (!Event.Label.IsNone())
+			{
+				Timeline.AbilityLabel = Event.Label;
+			}
+		}
+
+		TMap<FName, FAbilityLatency> PerAbility;
+		for (const TPair<uint32, FTraceTimeline>& Pair : Timelines)
+		{
+			using EStage = EIsekaiInputLatencyStage;
+			const FTraceTimeline& Timeline = Pair.Value;
+
+			// Traces that wrapped out of the ring before the input stage have no reference point
+			if (!Timeline.Has(EStage::InputStarted)) continue;
+
+			FAbilityLatency& Latency = PerAbility.FindOrAdd(Timeline.AbilityLabel.IsNone() ? Timeline.InputLabel : Timeline.AbilityLabel);
+			++Latency.NumTraces;
+			Latency.NumFailed += Timeline.Has(EStage::ActivationFailed) ? 1 : 0;
+			Latency.NumConfirmed += Timeline.Has(EStage::Confirmed) ? 1 : 0;
+			Latency.NumRejected += Timeline.Has(EStage::Rejected) ? 1 : 0;
+
+			auto AddSample = [&Latency](const ELatencyMetric Metric, const double Ms)
+			{
+				Latency.Metrics[static_cast<int32>(Metric)].SamplesMs.Add(Ms);
+			};
+
+			if (Timeline.Has(EStage::Processed)) AddSample(ELatencyMetric::InputToProcess, Timeline.DeltaMs(EStage::InputStarted, EStage::Processed));
+			if (Timeline.Has(EStage::Activated))
+			{
+				AddSample(ELatencyMetric::InputToActivate, Timeline.DeltaMs(EStage::InputStarted, EStage::Activated));
+				if (Timeline.Has(EStage::Confirmed)) AddSample(ELatencyMetric::ActivateToConfirm, Timeline.DeltaMs(EStage::Activated, EStage::Confirmed));
+				if (Timeline.Has(EStage::Rejected)) AddSample(ELatencyMetric::ActivateToReject, Timeline.DeltaMs(EStage::Activated, EStage::Rejected));
+			}
+			if (Timeline.Has(EStage::Confirmed)) AddSample(ELatencyMetric::InputToResolve, Timeline.DeltaMs(EStage::InputStarted, EStage::Confirmed));
+			else if (Timeline.Has(EStage::Rejected)) AddSample(ELatencyMetric::InputToResolve, Timeline.DeltaMs(EStage::InputStarted, EStage::Rejected));
+		}
+
+		for (TPair<FName, FAbilityLatency>& Pair : PerAbility)
+		{
+			for (FLatencyHistogram& Histogram : Pair.Value.Metrics)
+			{
+				Histogram.Finalize();
+			}
+		}
+
+		PerAbility.KeySort(FNameLexicalLess());
+		return PerAbility;
+	}
+}
+
+// --- Recording ---
+bool FIsekaiInputLatencyTracer::IsEnabled()
+{
+	return InputLatencyCVars::CVarEnable.GetValueOnGameThread();
+}
+
+uint32 FIsekaiInputLatencyTracer::BeginTrace(const FGameplayTag& InputTag)
+{
+	if (!IsEnabled())
+	{
+		return 0;
+	}
+
+	// Skip 0 on wrap-around, it means "not traced"
+	uint32 TraceId = NextTraceId++;
+	if (TraceId == 0)
+	{
+		TraceId = NextTraceId++;
+	}
+
+	RecordStage(TraceId, EIsekaiInputLatencyStage::InputStarted, InputTag.GetTagName());
+	return TraceId;
+}
+
+void FIsekaiInputLatencyTracer::RecordStage(const uint32 TraceId, const EIsekaiInputLatencyStage Stage, const FName Label)
+{
+	if (TraceId == 0)
+	{
+		return;
+	}
+
+	// The buffer is unsynchronized, a stage from another thread is dropped rather than racing the game thread
+	if (!ensureMsgf(IsInGameThread(), TEXT("FIsekaiInputLatencyTracer::RecordStage: Stages must be recorded on the game thread")))
+	{
+		return;
+	}
+
+	FTraceBuffer& Buffer = GetTraceBuffer();
+	FTraceEvent& Event = Buffer.Events[Buffer.WriteCount % FTraceBuffer::Capacity];
+	Event.Cycles = FPlatformTime::Cycles64();
+	Event.TraceId = TraceId;
+	Event.Stage = Stage;
+	Event.Label = Label;
+	++Buffer.WriteCount;
+}
+
+void FIsekaiInputLatencyTracer::TrackActivation(const uint32 TraceId, const FName AbilityName, FPredictionKey PredictionKey)
+{
+	if (TraceId == 0)
+	{
+		return;
+	}
+
+	RecordStage(TraceId, EIsekaiInputLatencyStage::Activated, AbilityName);
+
+	if (PredictionKey.IsLocalClientKey())
+	{
+		PredictionKey.NewCaughtUpDelegate().BindStatic(&OnPredictionKeyCaughtUp, TraceId);
+		PredictionKey.NewRejectedDelegate().BindStatic(&OnPredictionKeyRejected, TraceId);
+	}
+	else
+	{
+		// Server or standalone, nothing to wait for
+		RecordStage(TraceId, EIsekaiInputLatencyStage::Confirmed);
+	}
+}
+
+void FIsekaiInputLatencyTracer::Reset()
+{
+	check(IsInGameThread());
+
+	FTraceBuffer& Buffer = GetTraceBuffer();
+	Buffer.ReadStart = Buffer.WriteCount;
+}
+
+// --- Reporting ---
+void FIsekaiInputLatencyTracer::DumpToLog()
+{
+	const TMap<FName, FAbilityLatency> PerAbility = Aggregate();
+	if (PerAbility.IsEmpty())
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.InputLatency: No traces recorded%s"),
+			IsEnabled() ? TEXT("") : TEXT(" (enable with Isekai.InputLatency.Enable 1)"));
+		return;
+	}
+
+	FString BucketHeader;
+	for (const double Edge : BucketEdgesMs)
+	{
+		BucketHeader += FString::Printf(TEXT(" <=%g"), Edge);
+	}
+	BucketHeader += TEXT(" >");
+
+	UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.InputLatency: %d abilities, histogram buckets (ms):%s"), PerAbility.Num(), *BucketHeader);
+	for (const TPair<FName, FAbilityLatency>& Pair : PerAbility)
+	{
+		const FAbilityLatency& Latency = Pair.Value;
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  %s: %d traces, %d confirmed, %d rejected, %d failed locally"),
+			*Pair.Key.ToString(), Latency.NumTraces, Latency.NumConfirmed, Latency.NumRejected, Latency.NumFailed);
+
+		for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(ELatencyMetric::MAX); ++MetricIndex)
+		{
+			const FLatencyHistogram& Histogram = Latency.Metrics[MetricIndex];
+			if (Histogram.SamplesMs.IsEmpty()) continue;
+
+			FString Buckets;
+			for (const int32 Count : Histogram.Buckets)
+			{
+				Buckets += FString::Printf(TEXT(" %d"), Count);
+			}
+
+			UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("    %-18s n=%-5d min %.2f  p50 %.2f  p95 %.2f  max %.2f  mean %.2f ms |%s"),
+				MetricNames[MetricIndex], Histogram.SamplesMs.Num(),
+				Histogram.MinMs, Histogram.P50Ms, Histogram.P95Ms, Histogram.MaxMs, Histogram.MeanMs, *Buckets);
+		}
+	}
+}
+
+bool FIsekaiInputLatencyTracer::ExportCsv(const FString& FilePath)
+{
+	const TMap<FName, FAbilityLatency> PerAbility = Aggregate();
+
+	FString Csv = TEXT("Ability,Metric,Count,MinMs,P50Ms,P95Ms,MaxMs,MeanMs");
+	for (const double Edge : BucketEdgesMs)
+	{
+		Csv += FString::Printf(TEXT(",Le%gMs"), Edge);
+	}
+	Csv += FString::Printf(TEXT(",Gt%gMs\n"), BucketEdgesMs[UE_ARRAY_COUNT(BucketEdgesMs) - 1]);
+
+	for (const TPair<FName, FAbilityLatency>& Pair : PerAbility)
+	{
+		for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(ELatencyMetric::MAX); ++MetricIndex)
+		{
+			const FLatencyHistogram& Histogram = Pair.Value.Metrics[MetricIndex];
+			if (Histogram.SamplesMs.IsEmpty()) continue;
+
+			Csv += FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f"),
+				*Pair.Key.ToString(), MetricNames[MetricIndex], Histogram.SamplesMs.Num(),
+				Histogram.MinMs, Histogram.P50Ms, Histogram.P95Ms, Histogram.MaxMs, Histogram.MeanMs);
+			for (const int32 Count : Histogram.Buckets)
+			{
+				Csv += FString::Printf(TEXT(",%d"), Count);
+			}
+			Csv += TEXT("\n");
+		}
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+// --- Console ---
+static FAutoConsoleCommand CmdDumpInputLatency(
+	TEXT("Isekai.InputLatency.Dump"),
+	TEXT("Logs per-ability input latency histograms recorded while Isekai.InputLatency.Enable is on."),
+	FConsoleCommandDelegate::CreateStatic(&FIsekaiInputLatencyTracer::DumpToLog));
+
+static FAutoConsoleCommand CmdExportInputLatency(
+	TEXT("Isekai.InputLatency.ExportCsv"),
+	TEXT("Writes per-ability input latency histograms as CSV. Args: [Path=Saved/Profiling/InputLatency/InputLatency_<time>.csv]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProfilingDir() / TEXT("InputLatency") / FString::Printf(TEXT("InputLatency_%s.csv"), *FDateTime::Now().ToString());
+
+		if (FIsekaiInputLatencyTracer::ExportCsv(FilePath))
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.InputLatency.ExportCsv: Wrote %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.InputLatency.ExportCsv: Failed to write %s"), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand CmdResetInputLatency(
+	TEXT("Isekai.InputLatency.Reset"),
+	TEXT("Discards all recorded input latency traces."),
+	FConsoleCommandDelegate::CreateStatic(&FIsekaiInputLatencyTracer::Reset));
+
+#endif
@@ -0,0 +1,65 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayPrediction.h"
+#include "GameplayTagContainer.h"
+
+/** Input latency tracing is compiled out of shipping builds. Call sites are guarded with this. */
+#define ISEKAI_INPUT_LATENCY_TRACE !UE_BUILD_SHIPPING
+
+#if ISEKAI_INPUT_LATENCY_TRACE
+
+/** Stages an ability input passes through, in the order they normally occur. */
+enum class EIsekaiInputLatencyStage : uint8
+{
+	/** Enhanced Input Started reached the player controller. */
+	InputStarted,
+	/** The pressed input was picked up by ProcessAbilityInput. */
+	Processed,
+	/** Local (predicted on clients) activation succeeded. */
+	Activated,
+	/** Local activation was refused, e.g. blocked by tags or cost. */
+	ActivationFailed,
+	/** The server caught up with the prediction key, or the activation was authoritative. */
+	Confirmed,
+	/** The server rejected the prediction key. */
+	Rejected,
+	MAX
+};
+
+/**
+ * Traces ability input from the controller to the server's verdict on the prediction key.
+ * BeginTrace hands out an ID that the ASC carries alongside the pressed spec handles; every stage is timestamped into
+ * a ring buffer on the game thread, where input, activation and prediction key callbacks all run, and only the
+ * dump/export commands (also game thread) walk it to build per-ability latency histograms.
+ * All timestamps are taken on the owning client, so with a listen server and "Net PktLag=<ms>" the confirm stage
+ * shows the simulated round trip.
+ *
+ * Isekai.InputLatency.Enable 1 / Isekai.InputLatency.Dump / Isekai.InputLatency.ExportCsv [Path] / Isekai.InputLatency.Reset
+ */
+class AIASSESSMENT_API FIsekaiInputLatencyTracer
+{
+public:
+	static bool IsEnabled();
+
+	/** Starts a trace for an input press. Returns 0 (no trace) while tracing is disabled. */
+	static uint32 BeginTrace(const FGameplayTag& InputTag);
+
+	static void RecordStage(uint32 TraceId, EIsekaiInputLatencyStage Stage, FName Label = NAME_None);
+
+	/**
+	 * Records the activation and closes the trace when the server answers the prediction key.
+	 * Activations without a local client key were authoritative and are confirmed immediately.
+	 */
+	static void TrackActivation(uint32 TraceId, FName AbilityName, FPredictionKey PredictionKey);
+
+	/** Discards every event recorded so far. */
+	static void Reset();
+
+	static void DumpToLog();
+	static bool ExportCsv(const FString& FilePath);
+};
+
+#endif
@@ -0,0 +1,545 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiTelemetry.h"
+
+#if ISEKAI_TELEMETRY
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "Algo/Sort.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TelemetryCVars
+{
+	static TAutoConsoleVariable<float> CVarFlushInterval(
+		TEXT("Isekai.Telemetry.FlushInterval"),
+		0.5f,
+		TEXT("Seconds between background flushes of the telemetry rings to disk."),
+		ECVF_Default);
+}
+
+namespace
+{
+	constexpr uint32 FileMagic = 0x4C45544B; // "KTEL"
+	constexpr uint32 FileVersion = 2;
+
+	const TCHAR* const EventTypeNames[] = {
+		TEXT("StealthTransition"),
+		TEXT("SquadMessage"),
+		TEXT("AbilityActivated"),
+		TEXT("Death"),
+	};
+	static_assert(UE_ARRAY_COUNT(EventTypeNames) == static_cast<int32>(EIsekaiTelemetryEventType::MAX));
+
+	/** Single producer (the owning thread), single consumer (whoever drains under the registry lock). */
+	struct FThreadEventRing
+	{
+		static constexpr uint64 Capacity = 8192;
+
+		FIsekaiTelemetryEvent Events[Capacity];
+		std::atomic<uint64> WriteCount{0};
+		std::atomic<uint64> ReadCount{0};
+		std::atomic<uint32> DroppedCount{0};
+	};
+
+	/** Rings are registered once per thread and live until shutdown, so the thread-local pointer never dangles. */
+	struct FEventRingRegistry
+	{
+		FCriticalSection Lock;
+		TArray<TUniquePtr<FThreadEventRing>> Rings;
+	};
+
+	FEventRingRegistry& GetRegistry()
+	{
+		static FEventRingRegistry Registry;
+		return Registry;
+	}
+
+	thread_local FThreadEventRing* LocalEventRing = nullptr;
+
+	FThreadEventRing& GetLocalEventRing()
+	{
+		if (!LocalEventRing)
+		{
+			FEventRingRegistry& Registry = GetRegistry();
+			FScopeLock ScopeLock(&Registry.Lock);
+			LocalEventRing = Registry.Rings.Add_GetRef(MakeUnique<FThreadEventRing>()).Get();
+		}
+		return *LocalEventRing;
+	}
+
+	/** Moves every published event out of the rings. Returns the number of events dropped since the last drain. */
+	uint32 DrainRings(TArray<FIsekaiTelemetryEvent>& OutEvents)
+	{
+		uint32 NumDropped = 0;
+
+		FEventRingRegistry& Registry = GetRegistry();
+		FScopeLock ScopeLock(&Registry.Lock);
+		for (const TUniquePtr<FThreadEventRing>& Ring : Registry.Rings)
+		{
+			const uint64 WriteCount = Ring->WriteCount.load(std::memory_order_acquire);
+			for (uint64 Index = Ring->ReadCount.load(std::memory_order_relaxed); Index < WriteCount; ++Index)
+			{
+				OutEvents.Add(Ring->Events[Index % FThreadEventRing::Capacity]);
+			}
+			Ring->ReadCount.store(WriteCount, std::memory_order_release);
+			NumDropped += Ring->DroppedCount.exchange(0, std::memory_order_relaxed);
+		}
+		return NumDropped;
+	}
+
+	/**
+	 * Appends one block per flush:
+	 * NumEvents, NumNewNames, NumDropped, the new names, then Type, Cycles (since the file start), Label, Subject and
+	 * Other name indices, IntValue and FloatValue columns. Name index 0 is NAME_None, labels and subjects share the table.
+	 */
+	class FTelemetryWriter : public FRunnable
+	{
+	public:
+		FTelemetryWriter(TUniquePtr<IFileHandle> InFile, const uint64 InStartCycles)
+			: File(MoveTemp(InFile))
+			, StartCycles(InStartCycles)
+			, WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+		}
+
+		virtual ~FTelemetryWriter() override
+		{
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		}
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping.load(std::memory_order_acquire))
+			{
+				const float Interval = FMath::Max(0.05f, TelemetryCVars::CVarFlushInterval.GetValueOnAnyThread());
+				WakeEvent->Wait(FTimespan::FromSeconds(Interval));
+				Flush();
+			}
+
+			// Whatever was recorded before the flag went down
+			Flush();
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping.store(true, std::memory_order_release);
+			WakeEvent->Trigger();
+		}
+
+	private:
+		void Flush()
+		{
+			Events.Reset();
+			uint32 NumDropped = DrainRings(Events);
+			if (Events.IsEmpty() && NumDropped == 0)
+			{
+				return;
+			}
+
+			Algo::SortBy(Events, &FIsekaiTelemetryEvent::Cycles);
+
+			NewNames.Reset();
+			NameIndices.Reset(Events.Num() * 3);
+			for (const FIsekaiTelemetryEvent& Event : Events)
+			{
+				NameIndices.Add(IndexName(Event.Label));
+				NameIndices.Add(IndexName(Event.Subject));
+				NameIndices.Add(IndexName(Event.Other));
+			}
+
+			Bytes.Reset();
+			FMemoryWriter Ar(Bytes);
+
+			uint32 NumEvents = Events.Num();
+			uint32 NumNewNames = NewNames.Num();
+			Ar << NumEvents << NumNewNames << NumDropped;
+			for (FString& Name : NewNames)
+			{
+				Ar << Name;
+			}
+
+			for (FIsekaiTelemetryEvent& Event : Events)
+			{
+				uint8 Type = static_cast<uint8>(Event.Type);
+				Ar << Type;
+			}
+			for (const FIsekaiTelemetryEvent& Event : Events)
+			{
+				uint64 Cycles = Event.Cycles - StartCycles;
+				Ar << Cycles;
+			}
+			// Label, Subject and Other columns, interleaved in NameIndices
+			for (int32 Column = 0; Column < 3; ++Column)
+			{
+				for (int32 Index = Column; Index < NameIndices.Num(); Index += 3)
+				{
+					Ar << NameIndices[Index];
+				}
+			}
+			for (FIsekaiTelemetryEvent& Event : Events)
+			{
+				Ar << Event.IntValue;
+			}
+			for (FIsekaiTelemetryEvent& Event : Events)
+			{
+				Ar << Event.FloatValue;
+			}
+
+			File->Write(Bytes.GetData(), Bytes.Num());
+			File->Flush();
+		}
+
+		/** Index of Name in the file's string table, queuing it for this block's delta on first use. */
+		uint32 IndexName(const FName Name)
+		{
+			if (Name.IsNone())
+			{
+				return 0;
+			}
+
+			if (const uint32* Found = NameToIndex.Find(Name))
+			{
+				return *Found;
+			}
+
+			const uint32 NameIndex = NameToIndex.Num() + 1;
+			NameToIndex.Add(Name, NameIndex);
+			NewNames.Add(Name.ToString());
+			return NameIndex;
+		}
+
+		TUniquePtr<IFileHandle> File;
+		const uint64 StartCycles;
+		FEvent* WakeEvent;
+		std::atomic<bool> bStopping{false};
+
+		/** Only touched on the writer thread. */
+		TMap<FName, uint32> NameToIndex;
+		TArray<FIsekaiTelemetryEvent> Events;
+		TArray<uint32> NameIndices;
+		TArray<FString> NewNames;
+		TArray<uint8> Bytes;
+	};
+
+	struct FTelemetrySession
+	{
+		FCriticalSection Lock;
+		TUniquePtr<FTelemetryWriter> Writer;
+		TUniquePtr<FRunnableThread> Thread;
+		FString FilePath;
+	};
+
+	FTelemetrySession& GetSession()
+	{
+		static FTelemetrySession Session;
+		return Session;
+	}
+
+	void StopSession(FTelemetrySession& Session)
+	{
+		if (Session.Thread)
+		{
+			// Stops the writer and waits for its final flush
+			Session.Thread->Kill(true);
+			Session.Thread.Reset();
+		}
+		Session.Writer.Reset();
+	}
+}
+
+std::atomic<bool> FIsekaiTelemetry::bRecording{false};
+
+// --- Recording ---
+bool FIsekaiTelemetry::Start(const FString& FilePath)
+{
+	FTelemetrySession& Session = GetSession();
+	FScopeLock ScopeLock(&Session.Lock);
+
+	bRecording.store(false, std::memory_order_relaxed);
+	StopSession(Session);
+
+	const FString Path = FilePath.IsEmpty()
+		? FPaths::ProfilingDir() / TEXT("Telemetry") / FString::Printf(TEXT("Telemetry_%s.isktel"), *FDateTime::Now().ToString())
+		: FilePath;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*Path));
+	if (!File)
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::Start: Failed to open %s"), *Path);
+		return false;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	TArray<uint8> Header;
+	FMemoryWriter Ar(Header);
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	Ar << Magic << Version << SecondsPerCycle;
+	File->Write(Header.GetData(), Header.Num());
+
+	// Drop anything recorded after the previous session stopped
+	TArray<FIsekaiTelemetryEvent> StaleEvents;
+	DrainRings(StaleEvents);
+
+	Session.Writer = MakeUnique<FTelemetryWriter>(MoveTemp(File), StartCycles);
+	Session.Thread.Reset(FRunnableThread::Create(Session.Writer.Get(), TEXT("IsekaiTelemetryWriter"), 0, TPri_BelowNormal));
+	if (!Session.Thread)
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::Start: Failed to create the writer thread"));
+		Session.Writer.Reset();
+		return false;
+	}
+
+	Session.FilePath = Path;
+	bRecording.store(true, std::memory_order_release);
+
+	// Close the file cleanly if the session is still running at exit
+	static const FDelegateHandle PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&FIsekaiTelemetry::Stop);
+
+	UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("FIsekaiTelemetry::Start: Recording to %s"), *Path);
+	return true;
+}
+
+void FIsekaiTelemetry::Stop()
+{
+	FTelemetrySession& Session = GetSession();
+	FScopeLock ScopeLock(&Session.Lock);
+
+	if (!Session.Thread)
+	{
+		return;
+	}
+
+	bRecording.store(false, std::memory_order_relaxed);
+	StopSession(Session);
+
+	UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("FIsekaiTelemetry::Stop: Wrote %s"), *Session.FilePath);
+}
+
+void FIsekaiTelemetry::Record(const EIsekaiTelemetryEventType Type, const UObject* Subject, const UObject* Other, const FName Label, const int32 IntValue, const float FloatValue)
+{
+	FThreadEventRing& Ring = GetLocalEventRing();
+	const uint64 WriteCount = Ring.WriteCount.load(std::memory_order_relaxed);
+
+	// Full until the writer catches up, never overwrite events it hasn't read
+	if (WriteCount - Ring.ReadCount.load(std::memory_order_acquire) >= FThreadEventRing::Capacity)
+	{
+		Ring.DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FIsekaiTelemetryEvent& Event = Ring.Events[WriteCount % FThreadEventRing::Capacity];
+	Event.Cycles = FPlatformTime::Cycles64();
+	Event.Label = Label;
+	Event.Subject = Subject ? Subject->GetFName() : NAME_None;
+	Event.Other = Other ? Other->GetFName() : NAME_None;
+	Event.IntValue = IntValue;
+	Event.FloatValue = FloatValue;
+	Event.Type = Type;
+
+	Ring.WriteCount.store(WriteCount + 1, std::memory_order_release);
+}
+
+// --- Reading ---
+bool FIsekaiTelemetry::ConvertToCsv(const FString& InPath, const FString& OutPath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InPath))
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::ConvertToCsv: Failed to read %s"), *InPath);
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	double SecondsPerCycle = 0.0;
+	Ar << Magic << Version << SecondsPerCycle;
+	if (Ar.IsError() || Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::ConvertToCsv: %s is not a version %u telemetry file"), *InPath, FileVersion);
+		return false;
+	}
+
+	TArray<FString> Names;
+	Names.Add(FString());
+
+	TArray<uint8> Types;
+	TArray<uint64> Cycles;
+	TArray<uint32> LabelIndices;
+	TArray<uint32> SubjectIndices;
+	TArray<uint32> OtherIndices;
+	TArray<int32> IntValues;
+	TArray<float> FloatValues;
+
+	auto ReadColumn = [&Ar](auto& Column, const uint32 Num)
+	{
+		Column.SetNumUninitialized(Num);
+		for (auto& Value : Column)
+		{
+			Ar << Value;
+		}
+	};
+
+	FString Csv = TEXT("TimeSeconds,Type,Label,Subject,Other,IntValue,FloatValue\n");
+	uint64 TotalEvents = 0;
+	uint64 TotalDropped = 0;
+
+	while (!Ar.AtEnd())
+	{
+		uint32 NumEvents = 0;
+		uint32 NumNewNames = 0;
+		uint32 NumDropped = 0;
+		Ar << NumEvents << NumNewNames << NumDropped;
+
+		// A block cut short by a crash ends the file, keep what was complete
+		if (Ar.IsError() || NumEvents > Ar.TotalSize() - Ar.Tell())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::ConvertToCsv: %s is truncated"), *InPath);
+			break;
+		}
+
+		for (uint32 Index = 0; Index < NumNewNames && !Ar.IsError(); ++Index)
+		{
+			Ar << Names.AddDefaulted_GetRef();
+		}
+
+		ReadColumn(Types, NumEvents);
+		ReadColumn(Cycles, NumEvents);
+		ReadColumn(LabelIndices, NumEvents);
+		ReadColumn(SubjectIndices, NumEvents);
+		ReadColumn(OtherIndices, NumEvents);
+		ReadColumn(IntValues, NumEvents);
+		ReadColumn(FloatValues, NumEvents);
+
+		if (Ar.IsError())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::ConvertToCsv: %s is truncated"), *InPath);
+			break;
+		}
+
+		auto GetName = [&Names](const uint32 NameIndex) -> const FString&
+		{
+			return Names.IsValidIndex(NameIndex) ? Names[NameIndex] : Names[0];
+		};
+
+		for (uint32 Index = 0; Index < NumEvents; ++Index)
+		{
+			const TCHAR* TypeName = Types[Index] < UE_ARRAY_COUNT(EventTypeNames) ? EventTypeNames[Types[Index]] : TEXT("Unknown");
+
+			Csv += FString::Printf(TEXT("%.6f,%s,%s,%s,%s,%d,%g\n"),
+				Cycles[Index] * SecondsPerCycle, TypeName, *GetName(LabelIndices[Index]),
+				*GetName(SubjectIndices[Index]), *GetName(OtherIndices[Index]), IntValues[Index], FloatValues[Index]);
+		}
+
+		TotalEvents += NumEvents;
+		TotalDropped += NumDropped;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(OutPath));
+	if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("FIsekaiTelemetry::ConvertToCsv: Failed to write %s"), *OutPath);
+		return false;
+	}
+
+	UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("FIsekaiTelemetry::ConvertToCsv: Wrote %llu events to %s (%llu dropped while recording)"),
+		TotalEvents, *OutPath, TotalDropped);
+	return true;
+}
+
+// --- Console ---
+static FAutoConsoleCommand CmdStartTelemetry(
+	TEXT("Isekai.Telemetry.Start"),
+	TEXT("Starts recording gameplay telemetry. Args: [Path=Saved/Profiling/Telemetry/Telemetry_<time>.isktel]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FIsekaiTelemetry::Start(Args.Num() > 0 ? Args[0] : FString());
+	}));
+
+static FAutoConsoleCommand CmdStopTelemetry(
+	TEXT("Isekai.Telemetry.Stop"),
+	TEXT("Stops recording gameplay telemetry and closes the file."),
+	FConsoleCommandDelegate::CreateStatic(&FIsekaiTelemetry::Stop));
+
+static FAutoConsoleCommand CmdExportTelemetry(
+	TEXT("Isekai.Telemetry.ExportCsv"),
+	TEXT("Converts a telemetry file to CSV. Args: <In> [Out=<In>.csv]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.Telemetry.ExportCsv: Missing input path"));
+			return;
+		}
+
+		FIsekaiTelemetry::ConvertToCsv(Args[0], Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("csv")));
+	}));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand CmdBenchTelemetry(
+	TEXT("Isekai.Telemetry.Bench"),
+	TEXT("Times Record on the game thread and the drain on the writer side, in ring-sized batches. Args: [Events=1000000]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (FIsekaiTelemetry::IsRecording())
+		{
+			UE_LOG(LogIsekaiAbilitySystem, Warning, TEXT("Isekai.Telemetry.Bench: Stop recording first, the bench drains the rings itself"));
+			return;
+		}
+
+		const int32 NumEvents = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+		const FName Label(TEXT("Bench"));
+		const UObject* Subject = GetTransientPackage();
+
+		TArray<FIsekaiTelemetryEvent> Drained;
+		Drained.Reserve(FThreadEventRing::Capacity);
+		DrainRings(Drained);
+
+		uint64 RecordCycles = 0;
+		uint64 DrainCycles = 0;
+		for (int32 Done = 0; Done < NumEvents;)
+		{
+			const int32 BatchSize = FMath::Min<int32>(NumEvents - Done, FThreadEventRing::Capacity);
+
+			uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Index = 0; Index < BatchSize; ++Index)
+			{
+				FIsekaiTelemetry::Record(EIsekaiTelemetryEventType::AbilityActivated, Subject, nullptr, Label, Index, 1.f);
+			}
+			RecordCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			Drained.Reset();
+			StartCycles = FPlatformTime::Cycles64();
+			DrainRings(Drained);
+			DrainCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			Done += BatchSize;
+		}
+
+		const double RecordNs = FPlatformTime::ToSeconds64(RecordCycles) * 1e9 / NumEvents;
+		const double DrainNs = FPlatformTime::ToSeconds64(DrainCycles) * 1e9 / NumEvents;
+
+		// 1% of a 60 Hz frame
+		constexpr double BudgetNs = 0.01 * 1e9 / 60.0;
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Isekai.Telemetry.Bench: %d events, Record %.1f ns/event, drain %.1f ns/event (writer thread)"),
+			NumEvents, RecordNs, DrainNs);
+		UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("  %.0f events per frame fit in 1%% of a 16.7 ms frame"), BudgetNs / FMath::Max(RecordNs, 0.001));
+	}));
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** Structured telemetry is available in every build by default, recording is switched on at runtime. */
+#ifndef ISEKAI_TELEMETRY
+#define ISEKAI_TELEMETRY 1
+#endif
+
+enum class EIsekaiTelemetryEventType : uint8
+{
+	/** Subject: AI. Other: target. Int: new EStealthState. Float: alert value. */
+	StealthTransition,
+	/** Subject: sender. Other: target. Label: message tag. Int: EAlertUrgency. */
+	SquadMessage,
+	/** Subject: avatar. Label: ability class. Int: ability level. */
+	AbilityActivated,
+	/** Subject: avatar. */
+	Death,
+	MAX
+};
+
+/** Fixed-size event record. Labels and subjects stay FNames in memory and are turned into a string table by the writer. */
+struct FIsekaiTelemetryEvent
+{
+	uint64 Cycles = 0;
+	FName Label;
+	/**
+	 * Names of the objects involved, NAME_None for none. Unlike GetUniqueID they aren't recycled once an object is
+	 * collected, and they stay readable offline.
+	 */
+	FName Subject;
+	FName Other;
+	int32 IntValue = 0;
+	float FloatValue = 0.f;
+	EIsekaiTelemetryEventType Type = EIsekaiTelemetryEventType::MAX;
+};
+
+#if ISEKAI_TELEMETRY
+
+/**
+ * Binary gameplay event recorder.
+ * Record copies the event into a per-thread single-producer ring without locking or formatting. A background writer
+ * drains every ring at Isekai.Telemetry.FlushInterval and appends a block to the file: a delta of the name string
+ * table (labels and subjects) followed by one column per field, sorted by time. Events are dropped (and counted) if a ring fills up
+ * between flushes. ConvertToCsv, Isekai.Telemetry.ExportCsv and the IsekaiTelemetryToCsv commandlet read it back.
+ *
+ * Isekai.Telemetry.Start [Path] / Isekai.Telemetry.Stop / Isekai.Telemetry.ExportCsv <In> [Out] / Isekai.Telemetry.Bench
+ */
+class AIASSESSMENT_API FIsekaiTelemetry
+{
+public:
+	static bool IsRecording() { return bRecording.load(std::memory_order_relaxed); }
+
+	/** Opens FilePath (Saved/Profiling/Telemetry/<time>.isktel when empty) and starts the writer thread. */
+	static bool Start(const FString& FilePath = FString());
+
+	/** Stops recording, flushes what is left and closes the file. */
+	static void Stop();
+
+	static void Record(EIsekaiTelemetryEventType Type, const UObject* Subject, const UObject* Other = nullptr, FName Label = NAME_None, int32 IntValue = 0, float FloatValue = 0.f);
+
+	static bool ConvertToCsv(const FString& InPath, const FString& OutPath);
+
+private:
+	static std::atomic<bool> bRecording;
+};
+
+/** Records only while telemetry is on, the arguments aren't evaluated otherwise. */
+#define ISEKAI_TELEMETRY_EVENT(Type, ...) \
+	do \
+	{ \
+		if (FIsekaiTelemetry::IsRecording()) \
+		{ \
+			FIsekaiTelemetry::Record(EIsekaiTelemetryEventType::Type, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#else
+
+#define ISEKAI_TELEMETRY_EVENT(Type, ...) do {} while (0)
+
+#endif
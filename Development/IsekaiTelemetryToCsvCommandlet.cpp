@@ -0,0 +1,39 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiTelemetryToCsvCommandlet.h"
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/Development/IsekaiTelemetry.h"
+#include "Misc/Paths.h"
+
+UIsekaiTelemetryToCsvCommandlet::UIsekaiTelemetryToCsvCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UIsekaiTelemetryToCsvCommandlet::Main(const FString& Params)
+{
+#if ISEKAI_TELEMETRY
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogIsekaiAbilitySystem, Error, TEXT("IsekaiTelemetryToCsv: Missing -In=<File.isktel>"));
+		return 1;
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+	}
+
+	return FIsekaiTelemetry::ConvertToCsv(InPath, OutPath) ? 0 : 1;
+#else
+	UE_LOG(LogIsekaiAbilitySystem, Error, TEXT("IsekaiTelemetryToCsv: Telemetry is compiled out (ISEKAI_TELEMETRY=0)"));
+	return 1;
+#endif
+}
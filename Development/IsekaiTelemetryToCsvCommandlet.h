@@ -0,0 +1,22 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "IsekaiTelemetryToCsvCommandlet.generated.h"
+
+/**
+ * Offline reader for FIsekaiTelemetry files.
+ * UnrealEditor-Cmd <Project> -run=IsekaiTelemetryToCsv -In=<File.isktel> [-Out=<File.csv>]
+ */
+UCLASS()
+class AIASSESSMENT_API UIsekaiTelemetryToCsvCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UIsekaiTelemetryToCsvCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,24 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiStats.h"
+
+#if ISEKAI_STATS
+
+DEFINE_STAT(STAT_Isekai_ProcessAbilityInput);
+DEFINE_STAT(STAT_Isekai_ApplyEffectSpec);
+DEFINE_STAT(STAT_Isekai_MeleeAttackTrace);
+DEFINE_STAT(STAT_Isekai_StealthAlertUpdate);
+DEFINE_STAT(STAT_Isekai_StealthStimulus);
+DEFINE_STAT(STAT_Isekai_SquadBroadcast);
+DEFINE_STAT(STAT_Isekai_PatrolTask);
+DEFINE_STAT(STAT_Isekai_MovementProfiles);
+
+DEFINE_STAT(STAT_Isekai_StimuliProcessed);
+DEFINE_STAT(STAT_Isekai_SquadMessagesSent);
+DEFINE_STAT(STAT_Isekai_EffectApplications);
+DEFINE_STAT(STAT_Isekai_AttackTraces);
+
+CSV_DEFINE_CATEGORY_MODULE(AIASSESSMENT_API, Isekai, true);
+
+#endif
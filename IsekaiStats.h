@@ -0,0 +1,62 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+/**
+ * Isekai profiling is compiled out of shipping builds. Every scope and counter below goes through these macros,
+ * so one switch removes stats, trace scopes and CSV stats together.
+ *
+ * stat Isekai / Unreal Insights (cpu channel) / csvprofiler start -> "Isekai" category
+ */
+#ifndef ISEKAI_STATS
+#define ISEKAI_STATS !UE_BUILD_SHIPPING
+#endif
+
+#if ISEKAI_STATS
+
+DECLARE_STATS_GROUP(TEXT("Isekai"), STATGROUP_Isekai, STATCAT_Advanced);
+
+// --- Scopes ---
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability Input"), STAT_Isekai_ProcessAbilityInput, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Effect Spec"), STAT_Isekai_ApplyEffectSpec, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee Attack Trace"), STAT_Isekai_MeleeAttackTrace, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stealth Alert Update"), STAT_Isekai_StealthAlertUpdate, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stealth Stimulus"), STAT_Isekai_StealthStimulus, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Squad Broadcast"), STAT_Isekai_SquadBroadcast, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Patrol BT Tasks"), STAT_Isekai_PatrolTask, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement Profiles"), STAT_Isekai_MovementProfiles, STATGROUP_Isekai, AIASSESSMENT_API);
+
+// --- Counters (per frame) ---
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Stimuli Processed"), STAT_Isekai_StimuliProcessed, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Squad Messages Sent"), STAT_Isekai_SquadMessagesSent, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effect Applications"), STAT_Isekai_EffectApplications, STATGROUP_Isekai, AIASSESSMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Attack Traces"), STAT_Isekai_AttackTraces, STATGROUP_Isekai, AIASSESSMENT_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(AIASSESSMENT_API, Isekai);
+
+/**
+ * Cycle stat and CSV timing for the rest of the enclosing scope.
+ * The cycle stat already shows up as a named Insights scope when the stat named events are on, so no extra trace scope.
+ */
+#define ISEKAI_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	CSV_SCOPED_TIMING_STAT(Isekai, Stat)
+
+/** Adds to a per-frame counter stat and its CSV column. */
+#define ISEKAI_INC_COUNTER(Stat, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(Stat, Amount); \
+		CSV_CUSTOM_STAT(Isekai, Stat, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+
+#else
+
+#define ISEKAI_SCOPE_CYCLE_COUNTER(Stat)
+#define ISEKAI_INC_COUNTER(Stat, Amount) do {} while (0)
+
+#endif
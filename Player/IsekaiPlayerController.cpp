@@ -9,6 +9,7 @@
 #include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
 #include "AIAssessment/Character/IsekaiCharacterBase.h"
 #include "AIAssessment/Character/IsekaiPlayer.h"
+#include "AIAssessment/Development/IsekaiInputLatencyTracer.h"
 #include "AIAssessment/Input/IsekaiInputComponent.h"
 #include "AIAssessment/Widget/IsekaiPlayerHUD.h"
 #include "AIAssessment/IsekaiLoggingChannels.h"
@@ -151,7 +152,11 @@ void AIsekaiPlayerController::Input_AbilityTagPressed(FGameplayTag InputTag)
 {
 	if (UIsekaiAbilitySystemComponent* IsekaiASC = GetPawnAbilitySystemComponent())
 	{
+#if ISEKAI_INPUT_LATENCY_TRACE
+		IsekaiASC->AbilityInputTagPressed(InputTag, FIsekaiInputLatencyTracer::BeginTrace(InputTag));
+#else
 		IsekaiASC->AbilityInputTagPressed(InputTag);
+#endif
 	}
 }
 
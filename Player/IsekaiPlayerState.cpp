@@ -26,6 +26,29 @@ UAbilitySystemComponent* AIsekaiPlayerState::GetAbilitySystemComponent() const
 	return IsekaiAbilitySystemComponent;
 }
 
+void AIsekaiPlayerState::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	
+	// The player state is created at login, before the pawn is spawned and possessed, so start loading right away
+	if (HasAuthority() && !bStartupAbilitySetsApplied)
+	{
+		StartupAbilitySetsLoadHandle = UIsekaiAbilitySet::LoadAbilitySetsAsync(StartupAbilitySets,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleStartupAbilitySetsLoaded));
+	}
+}
+
+void AIsekaiPlayerState::HandleStartupAbilitySetsLoaded()
+{
+	StartupAbilitySetsLoadHandle.Reset();
+	
+	if (bStartupAbilitySetsGrantPending)
+	{
+		bStartupAbilitySetsGrantPending = false;
+		ApplyStartupAbilitySets();
+	}
+}
+
 void AIsekaiPlayerState::ApplyStartupAbilitySets()
 {
 	if (!HasAuthority() || !IsekaiAbilitySystemComponent)
@@ -38,13 +61,15 @@ void AIsekaiPlayerState::ApplyStartupAbilitySets()
 		return;
 	}
 	
-	for (UIsekaiAbilitySet* AbilitySet : StartupAbilitySets)
+	// Possession can beat the preload, grant once it completes instead of stalling the game thread on it
+	if (StartupAbilitySetsLoadHandle.IsValid() && StartupAbilitySetsLoadHandle->IsLoadingInProgress())
 	{
-		if (AbilitySet)
-		{
-			AbilitySet->GiveToAbilitySystem(IsekaiAbilitySystemComponent, &StartupAbilitySetHandles, this);
-		}
+		bStartupAbilitySetsGrantPending = true;
+		return;
 	}
+	
+	UIsekaiAbilitySet::GiveAbilitySetsToAbilitySystem(StartupAbilitySets, IsekaiAbilitySystemComponent, &StartupAbilitySetHandles, this);
+	StartupAbilitySetsLoadHandle.Reset();
 	bStartupAbilitySetsApplied = true;
 }
 
@@ -62,11 +87,8 @@ void AIsekaiPlayerState::ResetForRespawn()
 	const FGameplayEffectQuery RemoveNonPersistentQuery = FGameplayEffectQuery::MakeQuery_MatchNoEffectTags(PersistentTags);
 	IsekaiAbilitySystemComponent->RemoveActiveEffects(RemoveNonPersistentQuery);
 	
-	// Clear transient state effects handles
-	IsekaiAttributeSet->InvalidateTransientEffectHandles();
-	
-	// Clear death tag
-	IsekaiAbilitySystemComponent->RemoveReplicatedLooseGameplayTag(Tags::State::Dead);
+	// Clear Dead and Exhausted
+	IsekaiAbilitySystemComponent->ClearCharacterStates();
 	
 	// Restore core attributes using your default-attributes GE
 	if (RespawnAttributesEffect)
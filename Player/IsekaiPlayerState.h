@@ -45,6 +45,7 @@ public:
 	/**
 	 * Server-only: grants all configured StartupAbilitySets to the ASC.
 	 * Safe to call multiple times; will only apply once.
+	 * Deferred until the preload of the sets' classes completes if it is still running.
 	 */
 	void ApplyStartupAbilitySets();
 	
@@ -55,6 +56,10 @@ public:
 	void ResetForRespawn();
 	
 protected:
+	virtual void PostInitializeComponents() override;
+	
+	void HandleStartupAbilitySetsLoaded();
+	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Isekai|AbilitySystem")
 	TObjectPtr<UIsekaiAbilitySystemComponent> IsekaiAbilitySystemComponent;
 	
@@ -69,6 +74,12 @@ protected:
 	
 	FIsekaiAbilitySetGrantedHandles StartupAbilitySetHandles;
 	
+	/** Preload of the startup sets' soft classes, started as soon as the player state exists. */
+	TSharedPtr<FStreamableHandle> StartupAbilitySetsLoadHandle;
+	
+	/** Possession asked for the startup sets before the preload finished, they are granted when it does. */
+	bool bStartupAbilitySetsGrantPending = false;
+	
 	UPROPERTY()
 	bool bStartupAbilitySetsApplied = false;
 };
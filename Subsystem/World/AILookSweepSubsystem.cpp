@@ -0,0 +1,239 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AILookSweepSubsystem.h"
+
+#include "AIController.h"
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace LookSweepCVars
+{
+	static TAutoConsoleVariable<float> CVarRelevanceRadius(
+		TEXT("Isekai.LookSweep.RelevanceRadius"),
+		4000.f,
+		TEXT("Guards further than this from every player pawn sweep at the reduced rate."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<float> CVarReducedRate(
+		TEXT("Isekai.LookSweep.ReducedRate"),
+		5.f,
+		TEXT("Focal point updates per second for guards outside player relevance. <= 0 updates every frame."),
+		ECVF_Default);
+
+	static constexpr double RelevanceRefreshInterval = 0.5;
+}
+
+int32 UAILookSweepSubsystem::RegisterSweep(AAIController* Controller, const FAILookSweepParams& Params, UBehaviorTreeComponent* OwnerComp, const UBTTaskNode* OwnerTask)
+{
+	if (!Controller || !Controller->GetPawn())
+	{
+		UE_LOG(LogIsekaiAI, Warning, TEXT("UAILookSweepSubsystem::RegisterSweep: Invalid controller or pawn"));
+		return INDEX_NONE;
+	}
+
+	PruneStaleSweeps();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 Handle = NextHandle++;
+
+	HandleToIndex.Add(Handle, Handles.Num());
+	Handles.Add(Handle);
+	BaseForwards.Add(Params.BaseForward.GetSafeNormal2D());
+	StartTimes.Add(Now);
+	EndTimes.Add(Params.Duration > 0.f ? Now + Params.Duration : 0.0);
+	NextUpdateTimes.Add(0.0);
+	SweepSpeeds.Add(Params.SweepSpeed);
+	HalfAngles.Add(FMath::DegreesToRadians(Params.HalfAngle));
+	LookDistances.Add(Params.LookDistance);
+	// Assume relevance until the next refresh says otherwise, so a fresh sweep never starts stuttering
+	RelevantFlags.Add(1);
+	Controllers.Add(Controller);
+	OwnerComps.Add(OwnerComp);
+	OwnerTasks.Add(OwnerTask);
+
+	return Handle;
+}
+
+void UAILookSweepSubsystem::UnregisterSweep(const int32 SweepHandle)
+{
+	int32 Index = INDEX_NONE;
+	if (!HandleToIndex.RemoveAndCopyValue(SweepHandle, Index))
+	{
+		return;
+	}
+
+	RemoveAtSwap(Index);
+}
+
+void UAILookSweepSubsystem::RemoveAtSwap(const int32 Index)
+{
+	const int32 LastIndex = Handles.Num() - 1;
+	if (Index != LastIndex)
+	{
+		HandleToIndex[Handles[LastIndex]] = Index;
+	}
+
+	Handles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	BaseForwards.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	StartTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	EndTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NextUpdateTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SweepSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HalfAngles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LookDistances.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RelevantFlags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Controllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	OwnerComps.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	OwnerTasks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAILookSweepSubsystem::PruneStaleSweeps()
+{
+	// Backwards, RemoveAtSwap only moves already visited entries
+	for (int32 i = OwnerComps.Num() - 1; i >= 0; --i)
+	{
+		if (!OwnerComps[i].IsValid())
+		{
+			HandleToIndex.Remove(Handles[i]);
+			RemoveAtSwap(i);
+		}
+	}
+}
+
+void UAILookSweepSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	PruneStaleSweeps();
+
+	const int32 NumSweeps = Handles.Num();
+	if (NumSweeps == 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (Now >= NextRelevanceRefreshTime)
+	{
+		RefreshRelevance(Now);
+		NextRelevanceRefreshTime = Now + LookSweepCVars::RelevanceRefreshInterval;
+	}
+
+	// 1. Evaluate every sweep angle in one tight pass over the SoA data
+	ScratchAngles.SetNumUninitialized(NumSweeps, EAllowShrinking::No);
+	for (int32 i = 0; i < NumSweeps; ++i)
+	{
+		ScratchAngles[i] = FMath::Sin(static_cast<float>(Now - StartTimes[i]) * SweepSpeeds[i]) * HalfAngles[i];
+	}
+
+	// 2. Decide which sweeps need a write this frame and which have expired
+	const float ReducedRate = LookSweepCVars::CVarReducedRate.GetValueOnGameThread();
+	const double ReducedInterval = ReducedRate > 0.f ? 1.0 / ReducedRate : 0.0;
+
+	ScratchDueIndices.Reset();
+	ScratchFinished.Reset();
+	for (int32 i = 0; i < NumSweeps; ++i)
+	{
+		if (EndTimes[i] > 0.0 && Now >= EndTimes[i])
+		{
+			ScratchFinished.Add({ OwnerComps[i], OwnerTasks[i], EBTNodeResult::Succeeded });
+			continue;
+		}
+
+		if (RelevantFlags[i] || Now >= NextUpdateTimes[i])
+		{
+			NextUpdateTimes[i] = RelevantFlags[i] ? 0.0 : Now + ReducedInterval;
+			ScratchDueIndices.Add(i);
+		}
+	}
+
+	// 3. Batch write focal points
+	for (const int32 i : ScratchDueIndices)
+	{
+		AAIController* AICon = Controllers[i].Get();
+		const APawn* Pawn = AICon ? AICon->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			// Let the owning task fail, it will unregister itself
+			ScratchFinished.Add({ OwnerComps[i], OwnerTasks[i], EBTNodeResult::Failed });
+			continue;
+		}
+
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, ScratchAngles[i]);
+
+		// Rotation about the up axis, equivalent to RotateAngleAxis(Angle, UpVector)
+		const FVector& Fwd = BaseForwards[i];
+		const FVector Dir(Fwd.X * Cos - Fwd.Y * Sin, Fwd.X * Sin + Fwd.Y * Cos, Fwd.Z);
+
+		AICon->SetFocalPoint(Pawn->GetActorLocation() + Dir * LookDistances[i], EAIFocusPriority::Gameplay);
+	}
+
+	// 4. Complete finished tasks last, finishing can synchronously start a new sweep and reshuffle the arrays
+	for (const FFinishedSweep& Finished : ScratchFinished)
+	{
+		if (UBehaviorTreeComponent* OwnerComp = Finished.OwnerComp.Get(); OwnerComp && Finished.Task)
+		{
+			Finished.Task->FinishLatentTask(*OwnerComp, Finished.Result);
+		}
+	}
+}
+
+void UAILookSweepSubsystem::RefreshRelevance(const double Now)
+{
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->IsValid() ? (*It)->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	const float Radius = LookSweepCVars::CVarRelevanceRadius.GetValueOnGameThread();
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+
+	for (int32 i = 0; i < Controllers.Num(); ++i)
+	{
+		const AAIController* AICon = Controllers[i].Get();
+		const APawn* Pawn = AICon ? AICon->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			RelevantFlags[i] = 1;
+			continue;
+		}
+
+		const FVector GuardLocation = Pawn->GetActorLocation();
+		bool bRelevant = false;
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			if (FVector::DistSquared(GuardLocation, PlayerLocation) <= RadiusSq)
+			{
+				bRelevant = true;
+				break;
+			}
+		}
+
+		// Becoming irrelevant: schedule the first reduced update instead of writing immediately
+		if (RelevantFlags[i] && !bRelevant)
+		{
+			NextUpdateTimes[i] = Now;
+		}
+		RelevantFlags[i] = bRelevant ? 1 : 0;
+	}
+}
+
+TStatId UAILookSweepSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAILookSweepSubsystem, STATGROUP_Tickables);
+}
+
+bool UAILookSweepSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
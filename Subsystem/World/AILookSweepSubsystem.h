@@ -0,0 +1,85 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AILookSweepSubsystem.generated.h"
+
+class AAIController;
+class UBehaviorTreeComponent;
+class UBTTaskNode;
+
+/** Parameters for a single look-around sweep. */
+struct FAILookSweepParams
+{
+	FVector BaseForward = FVector::ForwardVector;
+	float HalfAngle = 45.f;
+	float LookDistance = 1000.f;
+	float SweepSpeed = 2.f;
+	/** 0 = Infinite. */
+	float Duration = 0.f;
+};
+
+/**
+ * Owns every active look-around sweep in the world.
+ * Sweeps are stored as parallel arrays and evaluated in a single pass per frame,
+ * then focal points are written back in one batch. Guards far from any player are updated at a reduced rate.
+ */
+UCLASS()
+class AIASSESSMENT_API UAILookSweepSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- Registration ---
+	/** Starts a sweep for the given controller. Returns a handle used to unregister, INDEX_NONE on failure. */
+	int32 RegisterSweep(AAIController* Controller, const FAILookSweepParams& Params, UBehaviorTreeComponent* OwnerComp, const UBTTaskNode* OwnerTask);
+	void UnregisterSweep(int32 SweepHandle);
+
+	int32 GetNumActiveSweeps() const { return Controllers.Num(); }
+
+	// --- FTickableGameObject ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RemoveAtSwap(int32 Index);
+	/** Drops sweeps whose behavior tree component was destroyed without finishing the task, nothing would unregister them. */
+	void PruneStaleSweeps();
+	void RefreshRelevance(double Now);
+
+	// --- Sweep Store (SoA, all arrays share the same index) ---
+	TArray<int32> Handles;
+	TArray<FVector> BaseForwards;
+	TArray<double> StartTimes;
+	TArray<double> EndTimes;
+	TArray<double> NextUpdateTimes;
+	TArray<float> SweepSpeeds;
+	TArray<float> HalfAngles;
+	TArray<float> LookDistances;
+	TArray<uint8> RelevantFlags;
+	TArray<TWeakObjectPtr<AAIController>> Controllers;
+	TArray<TWeakObjectPtr<UBehaviorTreeComponent>> OwnerComps;
+	TArray<const UBTTaskNode*> OwnerTasks;
+
+	/** Handle -> dense index. */
+	TMap<int32, int32> HandleToIndex;
+	int32 NextHandle = 0;
+	double NextRelevanceRefreshTime = 0.0;
+
+	// --- Per-frame scratch, kept around to avoid reallocating ---
+	TArray<float> ScratchAngles;
+	TArray<int32> ScratchDueIndices;
+	struct FFinishedSweep
+	{
+		TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp;
+		const UBTTaskNode* Task = nullptr;
+		EBTNodeResult::Type Result = EBTNodeResult::Succeeded;
+	};
+	TArray<FFinishedSweep> ScratchFinished;
+};
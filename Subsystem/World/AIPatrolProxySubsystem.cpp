@@ -0,0 +1,407 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AIPatrolProxySubsystem.h"
+
+#include "AIPoolSubsystem.h"
+#include "EngineUtils.h"
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/Actor/IsekaiPatrolPath.h"
+#include "AIAssessment/Character/IsekaiAICharacter.h"
+#include "AIAssessment/Component/AIStealthComponent.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "Algo/Sort.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+
+bool UAIPatrolProxySubsystem::AddPatroller(const TSubclassOf<AIsekaiAICharacter> CharacterClass, AIsekaiPatrolPath* Path,
+	const float DistanceAlongPath, const float Speed, const int32 SquadID, const float AlertSeed)
+{
+	if (!CharacterClass || !Path || !Path->GetSpatialIndex().IsValid())
+	{
+		UE_LOG(LogIsekaiAI, Warning, TEXT("UAIPatrolProxySubsystem::AddPatroller: Invalid class or patrol path without spatial index"));
+		return false;
+	}
+
+	const int32 Slot = FindOrAddPathSlot(Path);
+
+	Distances.Add(FMath::Clamp(DistanceAlongPath, 0.f, PathLengths[Slot]));
+	Speeds.Add(FMath::Max(Speed, 0.f));
+	Directions.Add(1.f);
+	PathSlots.Add(Slot);
+	SquadIDs.Add(SquadID);
+	AlertSeeds.Add(AlertSeed);
+	// Filled by the next sample pass
+	Locations.Add(FVector::ZeroVector);
+	Headings.Add(FVector::ForwardVector);
+	CharacterClasses.Add(CharacterClass);
+
+	return true;
+}
+
+void UAIPatrolProxySubsystem::TrackAI(AIsekaiAICharacter* Character)
+{
+	if (Character && Character->HasAuthority())
+	{
+		TrackedAI.AddUnique(Character);
+	}
+}
+
+int32 UAIPatrolProxySubsystem::FindOrAddPathSlot(AIsekaiPatrolPath* Path)
+{
+	if (const int32* ExistingSlot = PathToSlot.Find(Path))
+	{
+		return *ExistingSlot;
+	}
+
+	const int32 Slot = Paths.Add(Path);
+	PathLengths.Add(Path->GetSpatialIndex().GetLength());
+	PathLooping.Add(Path->IsLooping() ? 1 : 0);
+	PathToSlot.Add(Path, Slot);
+	return Slot;
+}
+
+void UAIPatrolProxySubsystem::RemoveProxyAtSwap(const int32 Index)
+{
+	Distances.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Speeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Directions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PathSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SquadIDs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AlertSeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Headings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CharacterClasses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAIPatrolProxySubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (GetWorld()->GetNetMode() == NM_Client) return;
+
+	const UIsekaiAISettings* Settings = GetDefault<UIsekaiAISettings>();
+	if (!Settings->bEnablePatrolProxies) return;
+
+	AdvanceProxies(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < NextCheckTime) return;
+	NextCheckTime = Now + Settings->ProxyCheckInterval;
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->IsValid() ? (*It)->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	SampleProxies();
+	HydrateProxies();
+	DehydrateTrackedAI();
+}
+
+void UAIPatrolProxySubsystem::AdvanceProxies(const float DeltaTime)
+{
+	const int32 NumProxies = Distances.Num();
+	for (int32 i = 0; i < NumProxies; ++i)
+	{
+		const int32 Slot = PathSlots[i];
+		const float Length = PathLengths[Slot];
+		float Distance = Distances[i] + Speeds[i] * Directions[i] * DeltaTime;
+
+		if (PathLooping[Slot])
+		{
+			Distance = Length > 0.f ? FMath::Fmod(Distance, Length) : 0.f;
+			Distance += Distance < 0.f ? Length : 0.f;
+		}
+		else if (Distance > Length)
+		{
+			Distance = FMath::Max(2.f * Length - Distance, 0.f);
+			Directions[i] = -1.f;
+		}
+		else if (Distance < 0.f)
+		{
+			Distance = FMath::Min(-Distance, Length);
+			Directions[i] = 1.f;
+		}
+
+		Distances[i] = Distance;
+	}
+}
+
+void UAIPatrolProxySubsystem::SampleProxies()
+{
+	const int32 NumProxies = Distances.Num();
+	ScratchHydrate.Reset();
+	if (NumProxies == 0) return;
+
+	// Refresh slot data, paths can rebuild their index at runtime
+	for (int32 Slot = 0; Slot < Paths.Num(); ++Slot)
+	{
+		const AIsekaiPatrolPath* Path = Paths[Slot].Get();
+		PathLengths[Slot] = Path ? Path->GetSpatialIndex().GetLength() : 0.f;
+	}
+
+	// Group by path, then by distance, so each path is sampled in one forward walk over its polyline
+	ScratchSampleIndices.SetNumUninitialized(NumProxies, EAllowShrinking::No);
+	for (int32 i = 0; i < NumProxies; ++i)
+	{
+		ScratchSampleIndices[i] = i;
+	}
+	Algo::Sort(ScratchSampleIndices, [this](const int32 A, const int32 B)
+	{
+		return PathSlots[A] != PathSlots[B] ? PathSlots[A] < PathSlots[B] : Distances[A] < Distances[B];
+	});
+
+	TArray<int32, TInlineAllocator<16>> Orphaned;
+	for (int32 RunStart = 0; RunStart < NumProxies;)
+	{
+		const int32 Slot = PathSlots[ScratchSampleIndices[RunStart]];
+		int32 RunEnd = RunStart + 1;
+		while (RunEnd < NumProxies && PathSlots[ScratchSampleIndices[RunEnd]] == Slot)
+		{
+			++RunEnd;
+		}
+		const int32 RunLength = RunEnd - RunStart;
+
+		const AIsekaiPatrolPath* Path = Paths[Slot].Get();
+		if (!Path || !Path->GetSpatialIndex().IsValid())
+		{
+			// Path streamed out, its proxies go with it
+			for (int32 Run = RunStart; Run < RunEnd; ++Run)
+			{
+				Orphaned.Add(ScratchSampleIndices[Run]);
+			}
+			RunStart = RunEnd;
+			continue;
+		}
+
+		ScratchSampleDistances.SetNumUninitialized(RunLength, EAllowShrinking::No);
+		ScratchSampleLocations.SetNumUninitialized(RunLength, EAllowShrinking::No);
+		ScratchSampleDirections.SetNumUninitialized(RunLength, EAllowShrinking::No);
+		for (int32 Run = 0; Run < RunLength; ++Run)
+		{
+			ScratchSampleDistances[Run] = Distances[ScratchSampleIndices[RunStart + Run]];
+		}
+
+		Path->GetSpatialIndex().SampleAtDistances(ScratchSampleDistances, ScratchSampleLocations, ScratchSampleDirections);
+
+		for (int32 Run = 0; Run < RunLength; ++Run)
+		{
+			const int32 Index = ScratchSampleIndices[RunStart + Run];
+			Locations[Index] = ScratchSampleLocations[Run];
+			Headings[Index] = ScratchSampleDirections[Run] * Directions[Index];
+		}
+
+		RunStart = RunEnd;
+	}
+
+	if (Orphaned.Num() > 0)
+	{
+		// Remove back to front so swapped-in rows are never ones still to be removed. Hydration waits for the next check.
+		Algo::Sort(Orphaned, TGreater<int32>());
+		for (const int32 Index : Orphaned)
+		{
+			RemoveProxyAtSwap(Index);
+		}
+		UE_LOG(LogIsekaiAI, Log, TEXT("UAIPatrolProxySubsystem::SampleProxies: Dropped %d proxies on unloaded patrol paths"), Orphaned.Num());
+		return;
+	}
+
+	const double HydrateRadiusSq = FMath::Square(static_cast<double>(GetDefault<UIsekaiAISettings>()->ProxyHydrateRadius));
+	for (int32 i = 0; i < NumProxies; ++i)
+	{
+		if (IsNearAnyPlayer(Locations[i], HydrateRadiusSq))
+		{
+			ScratchHydrate.Add(i);
+		}
+	}
+}
+
+void UAIPatrolProxySubsystem::HydrateProxies()
+{
+	if (ScratchHydrate.Num() == 0) return;
+
+	const int32 MaxHydrations = GetDefault<UIsekaiAISettings>()->MaxHydrationsPerCheck;
+	if (ScratchHydrate.Num() > MaxHydrations)
+	{
+		ScratchHydrate.SetNum(MaxHydrations, EAllowShrinking::No);
+	}
+
+	Algo::Sort(ScratchHydrate, TGreater<int32>());
+	for (const int32 Index : ScratchHydrate)
+	{
+		if (HydrateProxy(Index))
+		{
+			RemoveProxyAtSwap(Index);
+		}
+	}
+}
+
+bool UAIPatrolProxySubsystem::HydrateProxy(const int32 Index)
+{
+	AIsekaiPatrolPath* Path = Paths[PathSlots[Index]].Get();
+	UAIPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAIPoolSubsystem>();
+	const TSubclassOf<AIsekaiAICharacter> CharacterClass = CharacterClasses[Index];
+	if (!Path || !PoolSubsystem || !CharacterClass) return false;
+
+	// Path samples sit on the ground, the actor origin is the capsule center
+	const AIsekaiAICharacter* DefaultCharacter = CharacterClass->GetDefaultObject<AIsekaiAICharacter>();
+	const float HalfHeight = DefaultCharacter->GetCapsuleComponent() ? DefaultCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.f;
+	const FTransform Transform(FRotator(0.f, Headings[Index].Rotation().Yaw, 0.f), Locations[Index] + FVector(0.f, 0.f, HalfHeight));
+
+	FIsekaiAISpawnParams Params;
+	Params.PatrolPath = Path;
+	Params.SquadID = SquadIDs[Index];
+
+	AIsekaiAICharacter* Character = PoolSubsystem->AcquireAI(CharacterClass, Transform, Params);
+	if (!Character) return false;
+
+	// Possession already ran Init on the stealth component
+	if (UAIStealthComponent* StealthComp = Character->GetStealthComponent())
+	{
+		StealthComp->SeedAlertValue(AlertSeeds[Index]);
+	}
+
+	return true;
+}
+
+void UAIPatrolProxySubsystem::DehydrateTrackedAI()
+{
+	const double DehydrateRadiusSq = FMath::Square(static_cast<double>(GetDefault<UIsekaiAISettings>()->ProxyDehydrateRadius));
+	int32 Budget = GetDefault<UIsekaiAISettings>()->MaxHydrationsPerCheck;
+
+	for (int32 i = TrackedAI.Num() - 1; i >= 0 && Budget > 0; --i)
+	{
+		AIsekaiAICharacter* Character = TrackedAI[i].Get();
+
+		// Dead or pooled AI stop being tracked, they are tracked again on their next possession
+		if (!Character || Character->IsDead() || !Character->GetController())
+		{
+			TrackedAI.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (IsNearAnyPlayer(Character->GetActorLocation(), DehydrateRadiusSq)) continue;
+
+		const UAIStealthComponent* StealthComp = Character->GetStealthComponent();
+		if (StealthComp && StealthComp->GetCurrentStealthState() != EStealthState::Idle) continue;
+
+		if (DehydrateAI(Character))
+		{
+			TrackedAI.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			--Budget;
+		}
+	}
+}
+
+bool UAIPatrolProxySubsystem::DehydrateAI(AIsekaiAICharacter* Character)
+{
+	AIsekaiPatrolPath* Path = Character->GetPatrolPath().Get();
+	if (!Path || !Path->GetSpatialIndex().IsValid()) return false;
+
+	const FIsekaiPatrolPathSpatialIndex& SpatialIndex = Path->GetSpatialIndex();
+	const FVector Location = Character->GetActorLocation();
+
+	float Key = 0.f;
+	float DistSq = 0.f;
+	float PathDistance = 0.f;
+	if (SpatialIndex.FindClosestSegment(Location, Key, DistSq, &PathDistance) == INDEX_NONE) return false;
+
+	// Capture everything before the pool resets the actor
+	const UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement();
+	const float Speed = MoveComp ? MoveComp->GetMaxSpeed() : 0.f;
+	const FVector Velocity = MoveComp && !MoveComp->Velocity.IsNearlyZero() ? MoveComp->Velocity : Character->GetActorForwardVector();
+	const UAIStealthComponent* StealthComp = Character->GetStealthComponent();
+	const float AlertSeed = StealthComp ? StealthComp->GetAlertValue() : 0.f;
+	const int32 SquadID = Character->GetSquadID();
+	const TSubclassOf<AIsekaiAICharacter> CharacterClass = Character->GetClass();
+
+	FVector SampleLocation;
+	FVector SampleDirection;
+	SpatialIndex.SampleAtDistances(MakeArrayView(&PathDistance, 1), MakeArrayView(&SampleLocation, 1), MakeArrayView(&SampleDirection, 1));
+
+	// Parking also takes the AI out of its squad, the proxy keeps the ID to rejoin on hydration.
+	// A full pool keeps the AI live rather than destroying it, the next check tries again.
+	UAIPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAIPoolSubsystem>();
+	if (!PoolSubsystem || !PoolSubsystem->ReleaseAI(Character)) return false;
+
+	if (!AddPatroller(CharacterClass, Path, PathDistance, Speed, SquadID, AlertSeed)) return false;
+
+	const int32 NewIndex = Distances.Num() - 1;
+	Directions[NewIndex] = FVector::DotProduct(Velocity, SampleDirection) >= 0.f ? 1.f : -1.f;
+	Locations[NewIndex] = SampleLocation;
+	Headings[NewIndex] = SampleDirection * Directions[NewIndex];
+
+	return true;
+}
+
+bool UAIPatrolProxySubsystem::IsNearAnyPlayer(const FVector& Location, const double RadiusSq) const
+{
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		if (FVector::DistSquared(Location, PlayerLocation) <= RadiusSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TStatId UAIPatrolProxySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAIPatrolProxySubsystem, STATGROUP_Tickables);
+}
+
+bool UAIPatrolProxySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs CmdSpawnPatrolProxies(
+	TEXT("Isekai.PatrolProxy.Spawn"),
+	TEXT("Spreads proxies evenly over every patrol path in the world. Args: <CharacterClassPath> [CountPerPath=100] [Speed=200]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAIPatrolProxySubsystem* ProxySubsystem = World ? World->GetSubsystem<UAIPatrolProxySubsystem>() : nullptr;
+		if (!ProxySubsystem || Args.Num() < 1) return;
+
+		UClass* CharacterClass = StaticLoadClass(AIsekaiAICharacter::StaticClass(), nullptr, *Args[0]);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogIsekaiAI, Warning, TEXT("Isekai.PatrolProxy.Spawn: Could not load class %s"), *Args[0]);
+			return;
+		}
+
+		const int32 CountPerPath = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+		const float Speed = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 200.f;
+
+		int32 NumAdded = 0;
+		for (TActorIterator<AIsekaiPatrolPath> It(World); It; ++It)
+		{
+			const float Length = It->GetSpatialIndex().GetLength();
+			for (int32 i = 0; i < CountPerPath; ++i)
+			{
+				NumAdded += ProxySubsystem->AddPatroller(CharacterClass, *It, Length * i / CountPerPath, Speed) ? 1 : 0;
+			}
+		}
+
+		UE_LOG(LogIsekaiAI, Log, TEXT("Isekai.PatrolProxy.Spawn: Added %d proxies, %d total"), NumAdded, ProxySubsystem->GetNumProxies());
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdPatrolProxyStats(
+	TEXT("Isekai.PatrolProxy.Stats"),
+	TEXT("Logs the number of patrol proxies and tracked live AI."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UAIPatrolProxySubsystem* ProxySubsystem = World ? World->GetSubsystem<UAIPatrolProxySubsystem>() : nullptr)
+		{
+			UE_LOG(LogIsekaiAI, Log, TEXT("Isekai.PatrolProxy.Stats: %d proxies, %d tracked live AI"), ProxySubsystem->GetNumProxies(), ProxySubsystem->GetNumTracked());
+		}
+	}));
+#endif
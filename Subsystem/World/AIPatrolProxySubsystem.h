@@ -0,0 +1,93 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIPatrolProxySubsystem.generated.h"
+
+class AIsekaiAICharacter;
+class AIsekaiPatrolPath;
+
+/**
+ * Server-only store of idle patrollers that are too far from any player to need a real actor.
+ * A proxy is a row in a set of parallel arrays: distance along its patrol path, speed, direction, squad and residual alert.
+ * All proxies are advanced every frame in one pass, sampled against the path polyline on a slower check, and
+ * hydrated into full AIsekaiAICharacters through the AI pool when a player comes close. Idle AI that drift out of
+ * range are dehydrated back into proxies.
+ */
+UCLASS()
+class AIASSESSMENT_API UAIPatrolProxySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- Proxies ---
+	/** Adds a proxy at DistanceAlongPath. Returns false if the path has no usable spatial index. */
+	bool AddPatroller(TSubclassOf<AIsekaiAICharacter> CharacterClass, AIsekaiPatrolPath* Path, float DistanceAlongPath, float Speed, int32 SquadID = INDEX_NONE, float AlertSeed = 0.f);
+
+	/** Lets a live AI be dehydrated once every player is out of range and it is idle. */
+	void TrackAI(AIsekaiAICharacter* Character);
+
+	int32 GetNumProxies() const { return Distances.Num(); }
+	int32 GetNumTracked() const { return TrackedAI.Num(); }
+
+	// --- FTickableGameObject ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	int32 FindOrAddPathSlot(AIsekaiPatrolPath* Path);
+
+	/** Moves every proxy along its path. Looping paths wrap, open paths ping-pong like the patrol BT. */
+	void AdvanceProxies(float DeltaTime);
+
+	/** Samples proxy locations path by path and collects proxies within hydration range. */
+	void SampleProxies();
+
+	void HydrateProxies();
+	void DehydrateTrackedAI();
+
+	bool HydrateProxy(int32 Index);
+	bool DehydrateAI(AIsekaiAICharacter* Character);
+
+	bool IsNearAnyPlayer(const FVector& Location, double RadiusSq) const;
+
+	void RemoveProxyAtSwap(int32 Index);
+
+	// --- Proxy Store (SoA, all arrays share the same index) ---
+	TArray<float> Distances;
+	TArray<float> Speeds;
+	/** +1 forward, -1 backward. Kept as float so it multiplies straight into the advance step. */
+	TArray<float> Directions;
+	TArray<int32> PathSlots;
+	TArray<int32> SquadIDs;
+	TArray<float> AlertSeeds;
+	TArray<FVector> Locations;
+	TArray<FVector> Headings;
+
+	UPROPERTY()
+	TArray<TSubclassOf<AIsekaiAICharacter>> CharacterClasses;
+
+	// --- Path Slots (never removed, there are only a handful of paths per level) ---
+	TArray<TWeakObjectPtr<AIsekaiPatrolPath>> Paths;
+	TArray<float> PathLengths;
+	TArray<uint8> PathLooping;
+	TMap<TWeakObjectPtr<AIsekaiPatrolPath>, int32> PathToSlot;
+
+	/** Live AI that may be dehydrated. */
+	TArray<TWeakObjectPtr<AIsekaiAICharacter>> TrackedAI;
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	double NextCheckTime = 0.0;
+
+	// --- Per-check scratch, kept around to avoid reallocating ---
+	TArray<int32> ScratchHydrate;
+	TArray<int32> ScratchSampleIndices;
+	TArray<float> ScratchSampleDistances;
+	TArray<FVector> ScratchSampleLocations;
+	TArray<FVector> ScratchSampleDirections;
+};
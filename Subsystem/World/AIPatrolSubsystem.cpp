@@ -0,0 +1,215 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AIPatrolSubsystem.h"
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/Actor/IsekaiPatrolPath.h"
+#include "AIAssessment/Character/IsekaiAICharacter.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Level.h"
+
+namespace PatrolCVars
+{
+	static TAutoConsoleVariable<int32> CVarMaxOutstandingQueries(
+		TEXT("Isekai.Patrol.MaxOutstandingQueries"),
+		16,
+		TEXT("Maximum number of async patrol path queries in flight at once."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<int32> CVarMaxQueriesPerFrame(
+		TEXT("Isekai.Patrol.MaxQueriesPerFrame"),
+		4,
+		TEXT("Maximum number of async patrol path queries issued per frame."),
+		ECVF_Default);
+}
+
+namespace
+{
+	/** Actors placed in a level are subobjects of the map package, loading them means loading the map. */
+	bool IsLevelPlacedPath(const FSoftObjectPath& Path)
+	{
+		return !Path.GetSubPathString().IsEmpty();
+	}
+}
+
+void UAIPatrolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+}
+
+void UAIPatrolSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	
+	for (const auto& [Level, Handle] : LevelPreloadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	LevelPreloadHandles.Empty();
+	LevelPathWaits.Empty();
+	
+	Super::Deinitialize();
+}
+
+void UAIPatrolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	
+	// Levels that were already part of the world never fire LevelAddedToWorld
+	for (const ULevel* Level : InWorld.GetLevels())
+	{
+		PreloadPatrolPathsForLevel(Level);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UAIPatrolSubsystem::RequestPatrolPathLoad(const TSoftObjectPtr<AIsekaiPatrolPath>& PatrolPath, FStreamableDelegate OnLoaded)
+{
+	if (PatrolPath.IsNull()) return nullptr;
+	
+	if (PatrolPath.IsValid())
+	{
+		OnLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+	
+	if (IsLevelPlacedPath(PatrolPath.ToSoftObjectPath()))
+	{
+		LevelPathWaits.FindOrAdd(PatrolPath.ToSoftObjectPath()).Add(MoveTemp(OnLoaded));
+		return nullptr;
+	}
+	
+	// Requests for a path already in flight from a level preload are merged by the streamable manager
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(PatrolPath.ToSoftObjectPath(), MoveTemp(OnLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UAIPatrolSubsystem::CancelPatrolPathWaits(const UObject* Requester)
+{
+	for (auto It = LevelPathWaits.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([Requester](const FStreamableDelegate& Delegate) { return Delegate.IsBoundToObject(Requester); });
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UAIPatrolSubsystem::ResolveLevelPathWaits()
+{
+	TArray<FStreamableDelegate> Resolved;
+	for (auto It = LevelPathWaits.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObject())
+		{
+			Resolved.Append(MoveTemp(It.Value()));
+			It.RemoveCurrent();
+		}
+	}
+	
+	// Fired after iterating, a callback may register a new wait
+	for (const FStreamableDelegate& Delegate : Resolved)
+	{
+		Delegate.ExecuteIfBound();
+	}
+}
+
+void UAIPatrolSubsystem::PreloadPatrolPathsForLevel(const ULevel* Level)
+{
+	if (!Level || LevelPreloadHandles.Contains(Level)) return;
+	
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client) return;
+	
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const AActor* Actor : Level->Actors)
+	{
+		const AIsekaiAICharacter* AICharacter = Cast<AIsekaiAICharacter>(Actor);
+		if (!AICharacter) continue;
+		
+		// Level-placed paths come in with their own level
+		const TSoftObjectPtr<AIsekaiPatrolPath> PatrolPath = AICharacter->GetPatrolPath();
+		if (!PatrolPath.IsNull() && !PatrolPath.IsValid() && !IsLevelPlacedPath(PatrolPath.ToSoftObjectPath()))
+		{
+			PathsToLoad.AddUnique(PatrolPath.ToSoftObjectPath());
+		}
+	}
+	
+	if (PathsToLoad.Num() == 0) return;
+	
+	UE_LOG(LogIsekaiAI, Verbose, TEXT("UAIPatrolSubsystem::PreloadPatrolPathsForLevel: Preloading %d patrol paths for %s"),
+		PathsToLoad.Num(), *GetNameSafe(Level->GetOuter()));
+	
+	LevelPreloadHandles.Add(Level, UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToLoad),
+		FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority));
+}
+
+void UAIPatrolSubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		ResolveLevelPathWaits();
+		PreloadPatrolPathsForLevel(Level);
+	}
+}
+
+void UAIPatrolSubsystem::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld()) return;
+	
+	// A null level means the whole world is being torn down
+	if (!Level)
+	{
+		LevelPreloadHandles.Empty();
+		return;
+	}
+	
+	TSharedPtr<FStreamableHandle> Handle;
+	if (LevelPreloadHandles.RemoveAndCopyValue(Level, Handle) && Handle.IsValid())
+	{
+		Handle->ReleaseHandle();
+	}
+}
+
+bool UAIPatrolSubsystem::TryAcquirePathQuerySlot()
+{
+	if (IssueFrame != GFrameCounter)
+	{
+		IssueFrame = GFrameCounter;
+		IssuedThisFrame = 0;
+	}
+
+	if (IssuedThisFrame >= PatrolCVars::CVarMaxQueriesPerFrame.GetValueOnGameThread()
+		|| GetNumOutstandingPathQueries() >= PatrolCVars::CVarMaxOutstandingQueries.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	++IssuedThisFrame;
+	++PendingSlots;
+	return true;
+}
+
+void UAIPatrolSubsystem::TrackPathQuery(const uint32 QueryID)
+{
+	PendingSlots = FMath::Max(0, PendingSlots - 1);
+	OutstandingQueries.Add(QueryID);
+}
+
+void UAIPatrolSubsystem::ReleasePathQuerySlot()
+{
+	PendingSlots = FMath::Max(0, PendingSlots - 1);
+}
+
+void UAIPatrolSubsystem::ReleasePathQuery(const uint32 QueryID)
+{
+	OutstandingQueries.Remove(QueryID);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIPatrolSubsystem.generated.h"
+
+class AIsekaiPatrolPath;
+
+/**
+ * World-level coordination for patrolling AI.
+ * Budgets async navigation queries issued by patrol tasks so a wave of guards reaching their waypoints
+ * in the same frame can't flood the navigation system.
+ * Resolves patrol paths placed in other levels as those levels stream in, and streams paths that live in their own
+ * packages asynchronously, preloading every such path referenced by the guards of a level as it is added.
+ */
+UCLASS()
+class AIASSESSMENT_API UAIPatrolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	// --- USubsystem ---
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	
+	// --- Patrol Path Streaming ---
+	/**
+	 * OnLoaded fires once the patrol path is resident, immediately if it already is.
+	 * Level-placed paths are never streamed, since that would load their whole map. They are resolved when their level
+	 * is added to the world and nullptr is returned. Only paths in their own packages get a streamable handle.
+	 */
+	TSharedPtr<FStreamableHandle> RequestPatrolPathLoad(const TSoftObjectPtr<AIsekaiPatrolPath>& PatrolPath, FStreamableDelegate OnLoaded);
+	
+	/** Drops the level-placed path waits registered by Requester. Streamable handles are cancelled by their owner. */
+	void CancelPatrolPathWaits(const UObject* Requester);
+	
+	/** Issues a single batched load for every unloaded, separately packaged patrol path referenced by AI characters in the level. */
+	void PreloadPatrolPathsForLevel(const ULevel* Level);
+	
+	// --- Path Query Budget ---
+	/** Returns true if a new async path query may be issued this frame. Must be followed by TrackPathQuery or ReleasePathQuerySlot. */
+	bool TryAcquirePathQuerySlot();
+	/** Binds an acquired slot to the issued query ID. */
+	void TrackPathQuery(uint32 QueryID);
+	/** Frees a slot that was acquired but never turned into a query. */
+	void ReleasePathQuerySlot();
+	/** Frees the slot held by QueryID. Safe to call more than once for the same query. */
+	void ReleasePathQuery(uint32 QueryID);
+
+	int32 GetNumOutstandingPathQueries() const { return OutstandingQueries.Num() + PendingSlots; }
+
+private:
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+	
+	/** Fires the waits for every level-placed path that resolves now. */
+	void ResolveLevelPathWaits();
+	
+	/** Level-placed paths requested before their level was added to the world. */
+	TMap<FSoftObjectPath, TArray<FStreamableDelegate>> LevelPathWaits;
+	
+	/** Keeps batched preloads alive for the lifetime of the level that requested them. */
+	TMap<TObjectKey<ULevel>, TSharedPtr<FStreamableHandle>> LevelPreloadHandles;
+	
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	
+	TSet<uint32> OutstandingQueries;
+	int32 PendingSlots = 0;
+
+	uint64 IssueFrame = 0;
+	int32 IssuedThisFrame = 0;
+};
@@ -0,0 +1,158 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AIPerceptionBudgetSubsystem.h"
+
+#include "AIAssessment/AI/IsekaiAIController.h"
+#include "AIAssessment/Character/IsekaiAICharacter.h"
+#include "AIAssessment/Component/AIStealthComponent.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "Algo/Sort.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listeners"), STAT_IsekaiPerception_Listeners, STATGROUP_IsekaiPerception);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listeners Pending"), STAT_IsekaiPerception_Pending, STATGROUP_IsekaiPerception);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listeners Processed"), STAT_IsekaiPerception_Processed, STATGROUP_IsekaiPerception);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stimuli Processed"), STAT_IsekaiPerception_Stimuli, STATGROUP_IsekaiPerception);
+DECLARE_CYCLE_STAT(TEXT("Process Stimuli"), STAT_IsekaiPerception_Process, STATGROUP_IsekaiPerception);
+
+namespace
+{
+	uint8 GetListenerPriority(const AIsekaiAIController* Controller)
+	{
+		const AIsekaiAICharacter* AIChar = Cast<AIsekaiAICharacter>(Controller->GetPawn());
+		const UAIStealthComponent* StealthComp = AIChar ? AIChar->GetStealthComponent() : nullptr;
+		if (!StealthComp) return 0;
+
+		switch (StealthComp->GetCurrentStealthState())
+		{
+		case EStealthState::Alerted:	return 3;
+		case EStealthState::Searching:	return 2;
+		case EStealthState::Suspicious:	return 1;
+		default:						return 0;
+		}
+	}
+}
+
+void UAIPerceptionBudgetSubsystem::RegisterListener(AIsekaiAIController* Controller, const float MinProcessInterval)
+{
+	if (!Controller) return;
+
+	FListenerInfo& Info = Listeners.FindOrAdd(Controller);
+	Info.MinProcessInterval = MinProcessInterval;
+}
+
+void UAIPerceptionBudgetSubsystem::UnregisterListener(AIsekaiAIController* Controller)
+{
+	Listeners.Remove(Controller);
+}
+
+bool UAIPerceptionBudgetSubsystem::QueueStimulus(AIsekaiAIController* Controller, AActor* TargetActor, const FAIStimulus& Stimulus)
+{
+	FListenerInfo* Info = Listeners.Find(Controller);
+	if (!Info) return false;
+
+	// Only the latest state per target and sense matters, e.g. a "lost sight" replaces an unprocessed "sensed"
+	for (FQueuedStimulus& Queued : Info->Pending)
+	{
+		if (Queued.TargetActor == TargetActor && Queued.Stimulus.Type == Stimulus.Type)
+		{
+			Queued.Stimulus = Stimulus;
+			return true;
+		}
+	}
+
+	if (Info->Pending.Num() == 0)
+	{
+		Info->FirstQueuedTime = GetWorld()->GetTimeSeconds();
+	}
+	Info->Pending.Add({ TargetActor, Stimulus });
+	return true;
+}
+
+void UAIPerceptionBudgetSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_IsekaiPerception_Process);
+	SET_DWORD_STAT(STAT_IsekaiPerception_Listeners, Listeners.Num());
+
+	if (Listeners.Num() == 0) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// 1. Collect listeners with work that are allowed to run this frame
+	ScratchCandidates.Reset();
+	for (auto It = Listeners.CreateIterator(); It; ++It)
+	{
+		const AIsekaiAIController* Controller = It.Key().Get();
+		if (!Controller)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FListenerInfo& Info = It.Value();
+		if (Info.Pending.Num() == 0) continue;
+
+		const uint8 Priority = GetListenerPriority(Controller);
+		const bool bThrottled = Priority == 0 && Now - Info.LastProcessTime < Info.MinProcessInterval;
+		if (bThrottled) continue;
+
+		ScratchCandidates.Add({ It.Key(), Info.FirstQueuedTime, Priority });
+	}
+
+	SET_DWORD_STAT(STAT_IsekaiPerception_Pending, ScratchCandidates.Num());
+	if (ScratchCandidates.Num() == 0)
+	{
+		SET_DWORD_STAT(STAT_IsekaiPerception_Processed, 0);
+		SET_DWORD_STAT(STAT_IsekaiPerception_Stimuli, 0);
+		return;
+	}
+
+	// 2. Most urgent first, oldest first within a priority
+	const int32 MaxListeners = GetDefault<UIsekaiAISettings>()->MaxPerceptionListenersPerFrame;
+	const int32 NumToProcess = MaxListeners > 0 ? FMath::Min(MaxListeners, ScratchCandidates.Num()) : ScratchCandidates.Num();
+	if (NumToProcess < ScratchCandidates.Num())
+	{
+		Algo::Sort(ScratchCandidates, [](const FCandidate& A, const FCandidate& B)
+		{
+			return A.Priority != B.Priority ? A.Priority > B.Priority : A.FirstQueuedTime < B.FirstQueuedTime;
+		});
+	}
+
+	// 3. Process. Handling a stimulus can queue more (squad alerts), so the pending list is moved out first
+	int32 NumStimuli = 0;
+	for (int32 i = 0; i < NumToProcess; ++i)
+	{
+		FListenerInfo* Info = Listeners.Find(ScratchCandidates[i].Controller);
+		AIsekaiAIController* Controller = ScratchCandidates[i].Controller.Get();
+		if (!Info || !Controller) continue;
+
+		ScratchStimuli.Reset();
+		ScratchStimuli.Append(Info->Pending);
+		Info->Pending.Reset();
+		Info->LastProcessTime = Now;
+
+		for (const FQueuedStimulus& Queued : ScratchStimuli)
+		{
+			if (AActor* TargetActor = Queued.TargetActor.Get())
+			{
+				Controller->ProcessPerceptionStimulus(TargetActor, Queued.Stimulus);
+				++NumStimuli;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_IsekaiPerception_Processed, NumToProcess);
+	SET_DWORD_STAT(STAT_IsekaiPerception_Stimuli, NumStimuli);
+}
+
+TStatId UAIPerceptionBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAIPerceptionBudgetSubsystem, STATGROUP_Tickables);
+}
+
+bool UAIPerceptionBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Perception/AIPerceptionTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIPerceptionBudgetSubsystem.generated.h"
+
+class AIsekaiAIController;
+
+DECLARE_STATS_GROUP(TEXT("Isekai Perception"), STATGROUP_IsekaiPerception, STATCAT_Advanced);
+
+/**
+ * Server-only budget for game-side perception work.
+ * Perception updates are queued per listener (latest stimulus per target and sense wins) and at most
+ * MaxPerceptionListenersPerFrame listeners are processed each frame. Reacting guards go first: Alerted, Searching,
+ * Suspicious, then Idle, oldest first. Idle listeners are additionally throttled by their profile's process interval.
+ */
+UCLASS()
+class AIASSESSMENT_API UAIPerceptionBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- Registration ---
+	void RegisterListener(AIsekaiAIController* Controller, float MinProcessInterval);
+	/** Drops the listener and any stimuli still queued for it. */
+	void UnregisterListener(AIsekaiAIController* Controller);
+
+	/** @return false if the controller is not a registered listener, the caller should process the stimulus itself. */
+	bool QueueStimulus(AIsekaiAIController* Controller, AActor* TargetActor, const FAIStimulus& Stimulus);
+
+	int32 GetNumListeners() const { return Listeners.Num(); }
+
+	// --- FTickableGameObject ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FQueuedStimulus
+	{
+		TWeakObjectPtr<AActor> TargetActor;
+		FAIStimulus Stimulus;
+	};
+
+	struct FListenerInfo
+	{
+		TArray<FQueuedStimulus, TInlineAllocator<2>> Pending;
+		double FirstQueuedTime = 0.0;
+		double LastProcessTime = -UE_BIG_NUMBER;
+		float MinProcessInterval = 0.f;
+	};
+
+	struct FCandidate
+	{
+		TWeakObjectPtr<AIsekaiAIController> Controller;
+		double FirstQueuedTime = 0.0;
+		uint8 Priority = 0;
+	};
+
+	TMap<TWeakObjectPtr<AIsekaiAIController>, FListenerInfo> Listeners;
+
+	// --- Per-frame scratch, kept around to avoid reallocating ---
+	TArray<FCandidate> ScratchCandidates;
+	TArray<FQueuedStimulus> ScratchStimuli;
+};
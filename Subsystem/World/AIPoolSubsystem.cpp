@@ -0,0 +1,213 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AIPoolSubsystem.h"
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/Character/IsekaiAICharacter.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "Engine/AssetManager.h"
+
+namespace
+{
+	/** Prewarmed AI are spawned out of the way, they are hidden with collision off until acquired anyway. */
+	const FTransform PoolParkTransform(FVector(0.f, 0.f, 100000.f));
+}
+
+bool UAIPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer)) return false;
+	
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UAIPoolSubsystem::Deinitialize()
+{
+	if (PrewarmClassesLoadHandle.IsValid())
+	{
+		PrewarmClassesLoadHandle->CancelHandle();
+		PrewarmClassesLoadHandle.Reset();
+	}
+	
+	for (const auto& [CharacterClass, Handle] : AbilitySetLoadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	AbilitySetLoadHandles.Empty();
+	PendingPrewarmCounts.Empty();
+	
+	Super::Deinitialize();
+}
+
+void UAIPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	
+	if (InWorld.GetNetMode() == NM_Client || !IsPoolingEnabled()) return;
+	
+	TArray<FSoftObjectPath> ClassesToLoad;
+	for (const auto& [SoftClass, Count] : GetDefault<UIsekaiAISettings>()->PoolPrewarmCounts)
+	{
+		if (!SoftClass.IsNull() && !SoftClass.IsValid())
+		{
+			ClassesToLoad.Add(SoftClass.ToSoftObjectPath());
+		}
+	}
+	
+	if (ClassesToLoad.Num() == 0)
+	{
+		PrewarmFromSettings();
+		return;
+	}
+	
+	// Prewarm early in the level rather than during the first wave, without stalling BeginPlay on the class loads
+	PrewarmClassesLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(ClassesToLoad),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::PrewarmFromSettings), FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UAIPoolSubsystem::PrewarmFromSettings()
+{
+	PrewarmClassesLoadHandle.Reset();
+	
+	for (const auto& [SoftClass, Count] : GetDefault<UIsekaiAISettings>()->PoolPrewarmCounts)
+	{
+		if (const TSubclassOf<AIsekaiAICharacter> CharacterClass = SoftClass.Get())
+		{
+			PreloadAbilitySets(CharacterClass);
+			Prewarm(CharacterClass, Count);
+		}
+	}
+}
+
+void UAIPoolSubsystem::PreloadAbilitySets(const TSubclassOf<AIsekaiAICharacter> CharacterClass)
+{
+	if (!CharacterClass || AbilitySetLoadHandles.Contains(CharacterClass)) return;
+	
+	const AIsekaiAICharacter* CharacterCDO = CharacterClass->GetDefaultObject<AIsekaiAICharacter>();
+	AbilitySetLoadHandles.Add(CharacterClass, UIsekaiAbilitySet::LoadAbilitySetsAsync(CharacterCDO->GetStartupAbilitySets(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleAbilitySetsLoaded, TWeakObjectPtr<UClass>(CharacterClass))));
+}
+
+bool UAIPoolSubsystem::IsAbilitySetLoadPending(const TSubclassOf<AIsekaiAICharacter> CharacterClass) const
+{
+	const TSharedPtr<FStreamableHandle>* LoadHandle = AbilitySetLoadHandles.Find(CharacterClass);
+	return LoadHandle && LoadHandle->IsValid() && (*LoadHandle)->IsLoadingInProgress();
+}
+
+void UAIPoolSubsystem::HandleAbilitySetsLoaded(const TWeakObjectPtr<UClass> CharacterClass)
+{
+	int32 Count = 0;
+	if (CharacterClass.IsValid() && PendingPrewarmCounts.RemoveAndCopyValue(CharacterClass.Get(), Count))
+	{
+		Prewarm(CharacterClass.Get(), Count);
+	}
+}
+
+bool UAIPoolSubsystem::IsPoolingEnabled() const
+{
+	return GetDefault<UIsekaiAISettings>()->bEnableAIPooling;
+}
+
+AIsekaiAICharacter* UAIPoolSubsystem::AcquireAI(const TSubclassOf<AIsekaiAICharacter> CharacterClass, const FTransform& Transform, const FIsekaiAISpawnParams& Params)
+{
+	if (!CharacterClass) return nullptr;
+	
+	PreloadAbilitySets(CharacterClass);
+	
+	if (FIsekaiAIPoolBucket* Bucket = Pools.Find(CharacterClass))
+	{
+		while (Bucket->Inactive.Num() > 0)
+		{
+			AIsekaiAICharacter* Character = Bucket->Inactive.Pop(EAllowShrinking::No);
+			if (IsValid(Character))
+			{
+				Character->ActivateFromPool(Transform, Params);
+				return Character;
+			}
+		}
+	}
+	
+	// A fresh AI grants its startup sets in BeginPlay, don't spawn it before their classes are resident
+	if (IsAbilitySetLoadPending(CharacterClass)) return nullptr;
+	
+	return SpawnCharacter(CharacterClass, Transform, Params);
+}
+
+bool UAIPoolSubsystem::ReleaseAI(AIsekaiAICharacter* Character)
+{
+	if (!IsValid(Character) || !Character->HasAuthority() || !IsPoolingEnabled()) return false;
+	
+	// Checked before the capacity, a full pool would otherwise hand an already pooled AI back to be destroyed
+	FIsekaiAIPoolBucket& Bucket = Pools.FindOrAdd(Character->GetClass());
+	if (Bucket.Inactive.Contains(Character))
+	{
+		UE_LOG(LogIsekaiAI, Warning, TEXT("UAIPoolSubsystem::ReleaseAI: %s is already pooled"), *Character->GetName());
+		return true;
+	}
+	
+	if (Bucket.Inactive.Num() >= GetDefault<UIsekaiAISettings>()->MaxPooledPerClass) return false;
+	
+	Character->DeactivateForPool();
+	Bucket.Inactive.Add(Character);
+	return true;
+}
+
+void UAIPoolSubsystem::Prewarm(const TSubclassOf<AIsekaiAICharacter> CharacterClass, const int32 Count)
+{
+	if (!CharacterClass || !IsPoolingEnabled()) return;
+	
+	// Every prewarmed pawn grants the startup sets, come back once their classes are loaded instead of waiting on them
+	PreloadAbilitySets(CharacterClass);
+	if (IsAbilitySetLoadPending(CharacterClass))
+	{
+		int32& PendingCount = PendingPrewarmCounts.FindOrAdd(CharacterClass);
+		PendingCount = FMath::Max(PendingCount, Count);
+		return;
+	}
+	
+	const int32 Target = FMath::Min(Count, GetDefault<UIsekaiAISettings>()->MaxPooledPerClass);
+	FIsekaiAIPoolBucket& Bucket = Pools.FindOrAdd(CharacterClass);
+	Bucket.Inactive.Reserve(Target);
+	
+	while (Bucket.Inactive.Num() < Target)
+	{
+		AIsekaiAICharacter* Character = SpawnCharacter(CharacterClass, PoolParkTransform, FIsekaiAISpawnParams());
+		if (!Character) break;
+		
+		Character->DeactivateForPool();
+		Bucket.Inactive.Add(Character);
+	}
+	
+	UE_LOG(LogIsekaiAI, Log, TEXT("UAIPoolSubsystem::Prewarm: %d inactive %s ready"), Bucket.Inactive.Num(), *CharacterClass->GetName());
+}
+
+int32 UAIPoolSubsystem::GetNumInactive(const TSubclassOf<AIsekaiAICharacter> CharacterClass) const
+{
+	const FIsekaiAIPoolBucket* Bucket = Pools.Find(CharacterClass);
+	return Bucket ? Bucket->Inactive.Num() : 0;
+}
+
+AIsekaiAICharacter* UAIPoolSubsystem::SpawnCharacter(const TSubclassOf<AIsekaiAICharacter> CharacterClass, const FTransform& Transform, const FIsekaiAISpawnParams& Params) const
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParams.bDeferConstruction = true;
+	
+	AIsekaiAICharacter* Character = GetWorld()->SpawnActor<AIsekaiAICharacter>(CharacterClass, Transform, SpawnParams);
+	if (!Character) return nullptr;
+	
+	// Patrol path and squad must be in place before BeginPlay and possession read them
+	Character->ApplySpawnParams(Params);
+	Character->FinishSpawning(Transform);
+	
+	if (!Character->GetController())
+	{
+		Character->SpawnDefaultController();
+	}
+	
+	return Character;
+}
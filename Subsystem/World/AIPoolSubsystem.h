@@ -0,0 +1,88 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIPoolSubsystem.generated.h"
+
+class AIsekaiAICharacter;
+class AIsekaiPatrolPath;
+
+/** Per-spawn data applied to a pooled AI before it is possessed again. */
+struct FIsekaiAISpawnParams
+{
+	TSoftObjectPtr<AIsekaiPatrolPath> PatrolPath;
+	int32 SquadID = INDEX_NONE;
+};
+
+USTRUCT()
+struct FIsekaiAIPoolBucket
+{
+	GENERATED_BODY()
+	
+	UPROPERTY()
+	TArray<TObjectPtr<AIsekaiAICharacter>> Inactive;
+};
+
+/**
+ * Server-only pool of AI pawns and their controllers.
+ * Dead AI are deactivated and parked instead of destroyed, then reset and re-possessed on acquire,
+ * so wave spawns don't pay for actor construction, component registration and GC.
+ */
+UCLASS()
+class AIASSESSMENT_API UAIPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	// --- USubsystem ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	
+	bool IsPoolingEnabled() const;
+	
+	/**
+	 * Returns an active AI of the given class at Transform, recycled when possible.
+	 * Returns nullptr while a new AI would have to be spawned before the class's startup ability sets are loaded,
+	 * the load is started on the first call and the caller retries later.
+	 */
+	AIsekaiAICharacter* AcquireAI(TSubclassOf<AIsekaiAICharacter> CharacterClass, const FTransform& Transform, const FIsekaiAISpawnParams& Params = FIsekaiAISpawnParams());
+	
+	/**
+	 * Deactivates the AI and parks it in the pool.
+	 * @return false if the pool doesn't take it, the caller is then responsible for destroying it.
+	 */
+	bool ReleaseAI(AIsekaiAICharacter* Character);
+	
+	/** Spawns inactive AI until the pool for CharacterClass holds Count entries, once its startup ability sets are loaded. */
+	void Prewarm(TSubclassOf<AIsekaiAICharacter> CharacterClass, int32 Count);
+	
+	int32 GetNumInactive(TSubclassOf<AIsekaiAICharacter> CharacterClass) const;
+	
+	/** Starts loading the soft ability and effect classes of CharacterClass's startup sets, once per class. Never blocks. */
+	void PreloadAbilitySets(TSubclassOf<AIsekaiAICharacter> CharacterClass);
+	
+	bool IsAbilitySetLoadPending(TSubclassOf<AIsekaiAICharacter> CharacterClass) const;
+	
+private:
+	AIsekaiAICharacter* SpawnCharacter(TSubclassOf<AIsekaiAICharacter> CharacterClass, const FTransform& Transform, const FIsekaiAISpawnParams& Params) const;
+	
+	/** Prewarms every class of the settings' PoolPrewarmCounts that is loaded. */
+	void PrewarmFromSettings();
+	
+	/** Runs the prewarm that was deferred until the class's ability sets finished loading. */
+	void HandleAbilitySetsLoaded(TWeakObjectPtr<UClass> CharacterClass);
+	
+	/** Streams the prewarmed character classes in at level start. */
+	TSharedPtr<FStreamableHandle> PrewarmClassesLoadHandle;
+	
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FIsekaiAIPoolBucket> Pools;
+	
+	TMap<TObjectKey<UClass>, TSharedPtr<FStreamableHandle>> AbilitySetLoadHandles;
+	
+	/** Prewarm counts waiting on AbilitySetLoadHandles. */
+	TMap<TObjectKey<UClass>, int32> PendingPrewarmCounts;
+};
@@ -0,0 +1,229 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "AISignificanceSubsystem.h"
+
+#include "AIAssessment/AI/IsekaiAIController.h"
+#include "AIAssessment/Character/IsekaiAICharacter.h"
+#include "AIAssessment/Component/AIStealthComponent.h"
+#include "AIAssessment/Development/IsekaiAISettings.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace SignificanceCVars
+{
+	static TAutoConsoleVariable<int32> CVarForceTier(
+		TEXT("Isekai.Significance.ForceTier"),
+		-1,
+		TEXT("Forces every AI into the given tier (0 = High, 1 = Medium, 2 = Low, 3 = Dormant). -1 uses distance."),
+		ECVF_Cheat);
+}
+
+namespace
+{
+	EIsekaiAISignificance GetTierForDistanceSquared(const UIsekaiAISettings& Settings, const double DistSq)
+	{
+		for (uint8 TierIndex = 0; TierIndex < static_cast<uint8>(EIsekaiAISignificance::Dormant); ++TierIndex)
+		{
+			const EIsekaiAISignificance Tier = static_cast<EIsekaiAISignificance>(TierIndex);
+			if (DistSq <= FMath::Square(static_cast<double>(Settings.GetSignificanceDistance(Tier))))
+			{
+				return Tier;
+			}
+		}
+		return EIsekaiAISignificance::Dormant;
+	}
+}
+
+void UAISignificanceSubsystem::RegisterAI(AIsekaiAIController* Controller)
+{
+	if (!Controller || ControllerToIndex.Contains(Controller)) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	ControllerToIndex.Add(Controller, Controllers.Num());
+	Controllers.Add(Controller);
+	// Start from High so the first evaluation can demote without waiting for the dwell time
+	Tiers.Add(EIsekaiAISignificance::High);
+	LastTierChangeTimes.Add(-UE_BIG_NUMBER);
+
+	GatherPlayerLocations();
+	const int32 Index = Controllers.Num() - 1;
+	SetTier(Index, EvaluateTier(Index, Now), Now);
+}
+
+void UAISignificanceSubsystem::UnregisterAI(AIsekaiAIController* Controller)
+{
+	int32 Index = INDEX_NONE;
+	if (!ControllerToIndex.RemoveAndCopyValue(Controller, Index))
+	{
+		return;
+	}
+
+	RemoveAtSwap(Index);
+}
+
+EIsekaiAISignificance UAISignificanceSubsystem::GetSignificance(AIsekaiAIController* Controller) const
+{
+	const int32* Index = ControllerToIndex.Find(Controller);
+	return Index ? Tiers[*Index] : EIsekaiAISignificance::High;
+}
+
+int32 UAISignificanceSubsystem::GetNumInTier(const EIsekaiAISignificance Tier) const
+{
+	int32 Count = 0;
+	for (const EIsekaiAISignificance Current : Tiers)
+	{
+		Count += Current == Tier ? 1 : 0;
+	}
+	return Count;
+}
+
+void UAISignificanceSubsystem::RemoveAtSwap(const int32 Index)
+{
+	const int32 LastIndex = Controllers.Num() - 1;
+	if (Index != LastIndex)
+	{
+		ControllerToIndex[Controllers[LastIndex]] = Index;
+	}
+
+	Controllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Tiers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LastTierChangeTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAISignificanceSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const int32 NumAI = Controllers.Num();
+	if (NumAI == 0) return;
+
+	const UIsekaiAISettings* Settings = GetDefault<UIsekaiAISettings>();
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	GatherPlayerLocations();
+
+	// Spread a full pass over the update period, at least one AI per frame
+	int32 NumToUpdate = NumAI;
+	if (Settings->SignificanceUpdatePeriod > 0.f)
+	{
+		const float Budget = NumAI * DeltaTime / Settings->SignificanceUpdatePeriod + UpdateBudgetRemainder;
+		NumToUpdate = FMath::Clamp(FMath::FloorToInt32(Budget), 1, NumAI);
+		UpdateBudgetRemainder = FMath::Min(Budget - NumToUpdate, 1.f);
+	}
+
+	for (int32 Step = 0; Step < NumToUpdate && Controllers.Num() > 0; ++Step)
+	{
+		if (UpdateCursor >= Controllers.Num())
+		{
+			UpdateCursor = 0;
+		}
+
+		if (!Controllers[UpdateCursor].IsValid())
+		{
+			// Controller was destroyed without unregistering, the swapped-in entry is evaluated next step
+			ControllerToIndex.Remove(Controllers[UpdateCursor]);
+			RemoveAtSwap(UpdateCursor);
+			continue;
+		}
+
+		const EIsekaiAISignificance NewTier = EvaluateTier(UpdateCursor, Now);
+		if (NewTier != Tiers[UpdateCursor])
+		{
+			SetTier(UpdateCursor, NewTier, Now);
+		}
+
+		++UpdateCursor;
+	}
+}
+
+void UAISignificanceSubsystem::GatherPlayerLocations()
+{
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->IsValid() ? (*It)->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+}
+
+EIsekaiAISignificance UAISignificanceSubsystem::EvaluateTier(const int32 Index, const double Now) const
+{
+	const int32 ForcedTier = SignificanceCVars::CVarForceTier.GetValueOnGameThread();
+	if (ForcedTier >= 0 && ForcedTier < static_cast<int32>(EIsekaiAISignificance::MAX))
+	{
+		return static_cast<EIsekaiAISignificance>(ForcedTier);
+	}
+
+	const UIsekaiAISettings* Settings = GetDefault<UIsekaiAISettings>();
+	if (!Settings->bEnableSignificance)
+	{
+		return EIsekaiAISignificance::High;
+	}
+
+	const AIsekaiAIController* Controller = Controllers[Index].Get();
+	const AIsekaiAICharacter* AIChar = Controller ? Cast<AIsekaiAICharacter>(Controller->GetPawn()) : nullptr;
+	if (!AIChar)
+	{
+		return EIsekaiAISignificance::Dormant;
+	}
+
+	// A guard that is already reacting to a player keeps full fidelity, whatever the distance
+	if (const UAIStealthComponent* StealthComp = AIChar->GetStealthComponent();
+		StealthComp && StealthComp->GetCurrentStealthState() != EStealthState::Idle)
+	{
+		return EIsekaiAISignificance::High;
+	}
+
+	const FVector GuardLocation = AIChar->GetActorLocation();
+	double ClosestDistSq = TNumericLimits<double>::Max();
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(GuardLocation, PlayerLocation));
+	}
+
+	const EIsekaiAISignificance CurrentTier = Tiers[Index];
+	const EIsekaiAISignificance DesiredTier = GetTierForDistanceSquared(*Settings, ClosestDistSq);
+
+	// Promote immediately
+	if (DesiredTier <= CurrentTier)
+	{
+		return DesiredTier;
+	}
+
+	// Demote only after the dwell time, and only as far as the hysteresis band allows
+	if (Now - LastTierChangeTimes[Index] < Settings->MinTimeBeforeDemotion)
+	{
+		return CurrentTier;
+	}
+
+	const double ClosestDist = FMath::Sqrt(ClosestDistSq);
+	const double HysteresisDist = FMath::Max(ClosestDist - Settings->SignificanceHysteresis, 0.0);
+	const EIsekaiAISignificance DemotedTier = GetTierForDistanceSquared(*Settings, FMath::Square(HysteresisDist));
+
+	return FMath::Max(CurrentTier, DemotedTier);
+}
+
+void UAISignificanceSubsystem::SetTier(const int32 Index, const EIsekaiAISignificance NewTier, const double Now)
+{
+	Tiers[Index] = NewTier;
+	LastTierChangeTimes[Index] = Now;
+
+	if (AIsekaiAIController* Controller = Controllers[Index].Get())
+	{
+		Controller->ApplySignificanceTier(NewTier);
+	}
+}
+
+TStatId UAISignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAISignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UAISignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
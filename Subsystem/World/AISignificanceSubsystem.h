@@ -0,0 +1,63 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIAssessment/AI/IsekaiAITypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AISignificanceSubsystem.generated.h"
+
+class AIsekaiAIController;
+
+/**
+ * Server-only AI level of detail manager.
+ * Classifies every possessed guard into a significance tier by distance to the closest player and pushes
+ * tier changes to the controller, which throttles its brain, perception, movement and animation.
+ * Guards are re-evaluated round-robin over a fixed period so the cost stays flat with the population.
+ */
+UCLASS()
+class AIASSESSMENT_API UAISignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- Registration ---
+	/** Starts tracking the controller and applies its initial tier immediately. */
+	void RegisterAI(AIsekaiAIController* Controller);
+	void UnregisterAI(AIsekaiAIController* Controller);
+
+	EIsekaiAISignificance GetSignificance(AIsekaiAIController* Controller) const;
+	int32 GetNumInTier(EIsekaiAISignificance Tier) const;
+	int32 GetNumRegistered() const { return Controllers.Num(); }
+
+	// --- FTickableGameObject ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RemoveAtSwap(int32 Index);
+	void GatherPlayerLocations();
+
+	/** Returns the tier the AI at Index should be in, applying hysteresis against its current tier. */
+	EIsekaiAISignificance EvaluateTier(int32 Index, double Now) const;
+	void SetTier(int32 Index, EIsekaiAISignificance NewTier, double Now);
+
+	// --- AI Store (SoA, all arrays share the same index) ---
+	TArray<TWeakObjectPtr<AIsekaiAIController>> Controllers;
+	TArray<EIsekaiAISignificance> Tiers;
+	TArray<double> LastTierChangeTimes;
+
+	/** Controller -> dense index. Weak keys keep hashing stable after the controller is gone. */
+	TMap<TWeakObjectPtr<AIsekaiAIController>, int32> ControllerToIndex;
+
+	/** Next index to evaluate, wraps around. */
+	int32 UpdateCursor = 0;
+
+	/** Fractional part of the per-frame update budget carried to the next frame. */
+	float UpdateBudgetRemainder = 0.f;
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+};
@@ -4,6 +4,8 @@
 #include "AISquadSubsystem.h"
 
 #include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/IsekaiStats.h"
+#include "AIAssessment/Development/IsekaiTelemetry.h"
 #include "AIAssessment/Component/AISquadComponent.h"
 
 static TAutoConsoleVariable<bool> CVarDebugSquads(
@@ -24,7 +26,7 @@ void UAISquadSubsystem::RegisterMember(const int32 SquadID, UAISquadComponent* M
 	}
 	else
 	{
-		UE_LOG(LogIsekaiAI, Log, TEXT("UAISquadSubsystem::RegisterMember: Member %s is already registered in Squad %d"),
+		UE_LOG(LogIsekaiAI, Verbose, TEXT("UAISquadSubsystem::RegisterMember: Member %s is already registered in Squad %d"),
 			*Member->GetName(), SquadID);
 	}
 }
@@ -48,6 +50,8 @@ void UAISquadSubsystem::UnregisterMember(const int32 SquadID, UAISquadComponent*
 
 void UAISquadSubsystem::BroadcastMessage(int32 SquadID, const FSquadMessage& Message) const
 {
+	ISEKAI_SCOPE_CYCLE_COUNTER(STAT_Isekai_SquadBroadcast);
+	
 	if (!DoesSquadExist(SquadID))
 	{
 		UE_LOG(LogIsekaiAI, Log, TEXT("UAISquadSubsystem::BroadcastMessage: Squad %d does not exist"), SquadID);
@@ -56,6 +60,8 @@ void UAISquadSubsystem::BroadcastMessage(int32 SquadID, const FSquadMessage& Mes
 	
 	const auto& Members = Squads[SquadID];
 	
+	ISEKAI_TELEMETRY_EVENT(SquadMessage, Message.Sender, Message.TargetActor, Message.MessageTag.GetTagName(), static_cast<int32>(Message.Urgency.GetValue()));
+	
 	if (CVarDebugSquads.GetValueOnGameThread())
 	{
 		DrawDebugMessage(Message, Members);
@@ -66,6 +72,7 @@ void UAISquadSubsystem::BroadcastMessage(int32 SquadID, const FSquadMessage& Mes
 		if (MemberPtr.IsValid() && Message.Sender != MemberPtr->GetOwner())
 		{
 			MemberPtr->ReceiveMessage(Message);
+			ISEKAI_INC_COUNTER(STAT_Isekai_SquadMessagesSent, 1);
 		}
 	}
 }
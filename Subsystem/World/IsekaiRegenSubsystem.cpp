@@ -0,0 +1,567 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+
+#include "IsekaiRegenSubsystem.h"
+
+#include "AIAssessment/IsekaiLoggingChannels.h"
+#include "AIAssessment/NativeGameplayTags.h"
+#include "AIAssessment/AbilitySystem/IsekaiAbilitySystemComponent.h"
+#include "AIAssessment/AbilitySystem/IsekaiAttributeSet.h"
+#include "AIAssessment/Development/IsekaiAbilitySystemSettings.h"
+
+namespace RegenCVars
+{
+	static TAutoConsoleVariable<float> CVarTickRate(
+		TEXT("Isekai.Regen.TickRate"),
+		10.f,
+		TEXT("Fixed integration steps per second. <= 0 integrates every frame."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<float> CVarNetWriteInterval(
+		TEXT("Isekai.Regen.NetWriteInterval"),
+		0.2f,
+		TEXT("Seconds between attribute write backs of a changing value. Empty and full are always written immediately."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<bool> CVarStaminaTrajectory(
+		TEXT("Isekai.Regen.StaminaTrajectory"),
+		true,
+		TEXT("Replicates stamina as an analytic trajectory published on rate changes, instead of periodic attribute writes."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<float> CVarStaminaCorrectionInterval(
+		TEXT("Isekai.Regen.StaminaCorrectionInterval"),
+		2.f,
+		TEXT("Seconds between authoritative trajectory corrections while stamina is changing."),
+		ECVF_Default);
+}
+
+namespace
+{
+	FGameplayAttribute GetValueAttribute(const EIsekaiRegenChannel Channel)
+	{
+		return Channel == EIsekaiRegenChannel::Health ? UIsekaiAttributeSet::GetHealthAttribute() : UIsekaiAttributeSet::GetStaminaAttribute();
+	}
+
+	FGameplayTag GetBlockedTag(const EIsekaiRegenChannel Channel)
+	{
+		// Parent tags, so Stamina.RegenBlocked.Delay / .ActiveAbility count as blocked too
+		return Channel == EIsekaiRegenChannel::Health ? Tags::State::Health_RegenBlocked : Tags::State::Stamina_RegenBlocked;
+	}
+
+	/** Attributes that only feed the integration, changes to them refresh the row. */
+	TArray<FGameplayAttribute, TInlineAllocator<3>> GetInputAttributes(const EIsekaiRegenChannel Channel)
+	{
+		if (Channel == EIsekaiRegenChannel::Health)
+		{
+			return {UIsekaiAttributeSet::GetMaxHealthAttribute(), UIsekaiAttributeSet::GetHealthRegenRateAttribute(), UIsekaiAttributeSet::GetHealthRegenDelayAttribute()};
+		}
+		return {UIsekaiAttributeSet::GetMaxStaminaAttribute(), UIsekaiAttributeSet::GetStaminaRegenRateAttribute(), UIsekaiAttributeSet::GetStaminaRegenDelayAttribute()};
+	}
+
+	constexpr int32 NumChannels = static_cast<int32>(EIsekaiRegenChannel::MAX);
+
+	/** Moves the rows of FromEntry over ToEntry and drops the last entry's rows. */
+	template <typename T>
+	void MoveRowsAndShrink(TArray<T>& Rows, const int32 ToEntry, const int32 FromEntry)
+	{
+		if (ToEntry != FromEntry)
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				Rows[ToEntry * NumChannels + Channel] = Rows[FromEntry * NumChannels + Channel];
+			}
+		}
+		Rows.SetNum(Rows.Num() - NumChannels, EAllowShrinking::No);
+	}
+}
+
+bool UIsekaiRegenSubsystem::IsIntegrationEnabled()
+{
+	// Config only, no console override: clients pick their prediction from this and must agree with the server
+	return GetDefault<UIsekaiAbilitySystemSettings>()->bUseRegenSubsystem;
+}
+
+// --- Registration ---
+void UIsekaiRegenSubsystem::RegisterASC(UIsekaiAbilitySystemComponent* ASC, UIsekaiAttributeSet* AttributeSet)
+{
+	if (!IsIntegrationEnabled() || !ASC || !AttributeSet || !ASC->IsOwnerActorAuthoritative() || IsRegistered(ASC))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = ASCs.Num();
+	ASCToIndex.Add(ASC, EntryIndex);
+	ASCs.Add(ASC);
+	AttributeSets.Add(AttributeSet);
+	NextWriteTimes.Add(0.0);
+	NextCorrectionTimes.Add(0.0);
+	TrajectoryDirtyFlags.Add(1);
+	StaminaWriteCounts.Add(0);
+	TrajectoryPublishCounts.Add(0);
+
+	const TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC(ASC);
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const EIsekaiRegenChannel RegenChannel = static_cast<EIsekaiRegenChannel>(Channel);
+		const float Value = ASC->GetNumericAttribute(GetValueAttribute(RegenChannel));
+
+		Values.Add(Value);
+		Maxes.Add(Value);
+		RegenRates.Add(0.f);
+		DrainRates.Add(0.f);
+		RegenDelays.Add(0.f);
+		RegenResumeTimes.Add(0.0);
+		LastWrittenValues.Add(Value);
+		BlockedFlags.Add(0);
+		RefreshRowInputs(RowIndex(EntryIndex, RegenChannel));
+
+		ASC->GetGameplayAttributeValueChangeDelegate(GetValueAttribute(RegenChannel)).AddUObject(this, &ThisClass::OnValueChanged, WeakASC, RegenChannel);
+		for (const FGameplayAttribute& InputAttribute : GetInputAttributes(RegenChannel))
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(InputAttribute).AddUObject(this, &ThisClass::OnInputChanged, WeakASC, RegenChannel);
+		}
+		ASC->RegisterGameplayTagEvent(GetBlockedTag(RegenChannel), EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::OnBlockedTagChanged, WeakASC, RegenChannel);
+	}
+}
+
+void UIsekaiRegenSubsystem::UnregisterASC(UIsekaiAbilitySystemComponent* ASC)
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Flush(ASC);
+
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const EIsekaiRegenChannel RegenChannel = static_cast<EIsekaiRegenChannel>(Channel);
+		ASC->GetGameplayAttributeValueChangeDelegate(GetValueAttribute(RegenChannel)).RemoveAll(this);
+		for (const FGameplayAttribute& InputAttribute : GetInputAttributes(RegenChannel))
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(InputAttribute).RemoveAll(this);
+		}
+		ASC->RegisterGameplayTagEvent(GetBlockedTag(RegenChannel), EGameplayTagEventType::NewOrRemoved).RemoveAll(this);
+	}
+
+	RemoveEntryAtSwap(EntryIndex);
+}
+
+bool UIsekaiRegenSubsystem::IsRegistered(const UIsekaiAbilitySystemComponent* ASC) const
+{
+	return FindEntry(ASC) != INDEX_NONE;
+}
+
+int32 UIsekaiRegenSubsystem::FindEntry(const UIsekaiAbilitySystemComponent* ASC) const
+{
+	const int32* EntryIndex = ASCToIndex.Find(ASC);
+	return EntryIndex ? *EntryIndex : INDEX_NONE;
+}
+
+void UIsekaiRegenSubsystem::RemoveEntryAtSwap(const int32 EntryIndex)
+{
+	const int32 LastIndex = ASCs.Num() - 1;
+
+	ASCToIndex.Remove(ASCs[EntryIndex]);
+	if (EntryIndex != LastIndex)
+	{
+		ASCToIndex[ASCs[LastIndex]] = EntryIndex;
+	}
+
+	ASCs.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	AttributeSets.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	NextWriteTimes.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	NextCorrectionTimes.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	TrajectoryDirtyFlags.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	StaminaWriteCounts.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	TrajectoryPublishCounts.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+
+	MoveRowsAndShrink(Values, EntryIndex, LastIndex);
+	MoveRowsAndShrink(Maxes, EntryIndex, LastIndex);
+	MoveRowsAndShrink(RegenRates, EntryIndex, LastIndex);
+	MoveRowsAndShrink(DrainRates, EntryIndex, LastIndex);
+	MoveRowsAndShrink(RegenDelays, EntryIndex, LastIndex);
+	MoveRowsAndShrink(RegenResumeTimes, EntryIndex, LastIndex);
+	MoveRowsAndShrink(LastWrittenValues, EntryIndex, LastIndex);
+	MoveRowsAndShrink(BlockedFlags, EntryIndex, LastIndex);
+}
+
+// --- Drain & Delay ---
+bool UIsekaiRegenSubsystem::AddDrain(UIsekaiAbilitySystemComponent* ASC, const EIsekaiRegenChannel Channel, const float RatePerSecond)
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 Row = RowIndex(EntryIndex, Channel);
+	DrainRates[Row] += RatePerSecond;
+	MarkTrajectoryDirty(Row);
+	return true;
+}
+
+void UIsekaiRegenSubsystem::RemoveDrain(UIsekaiAbilitySystemComponent* ASC, const EIsekaiRegenChannel Channel, const float RatePerSecond)
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 Row = RowIndex(EntryIndex, Channel);
+	DrainRates[Row] = FMath::Max(0.f, DrainRates[Row] - RatePerSecond);
+	MarkTrajectoryDirty(Row);
+
+	// Land the exact value now rather than up to a net interval later
+	WriteBack(Row);
+}
+
+bool UIsekaiRegenSubsystem::DelayRegen(UIsekaiAbilitySystemComponent* ASC, const EIsekaiRegenChannel Channel)
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 Row = RowIndex(EntryIndex, Channel);
+	RegenResumeTimes[Row] = FMath::Max(RegenResumeTimes[Row], GetWorld()->GetTimeSeconds() + RegenDelays[Row]);
+	MarkTrajectoryDirty(Row);
+	return true;
+}
+
+void UIsekaiRegenSubsystem::Flush(const UIsekaiAbilitySystemComponent* ASC)
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const int32 Row = EntryIndex * NumChannels + Channel;
+		if (Values[Row] != LastWrittenValues[Row])
+		{
+			WriteBack(Row);
+		}
+	}
+}
+
+bool UIsekaiRegenSubsystem::GetIntegratedValue(const UIsekaiAbilitySystemComponent* ASC, const EIsekaiRegenChannel Channel, float& OutValue) const
+{
+	const int32 EntryIndex = FindEntry(ASC);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	
+	OutValue = Values[RowIndex(EntryIndex, Channel)];
+	return true;
+}
+
+// --- Integration ---
+void UIsekaiRegenSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// ASCs destroyed without unregistering
+	for (int32 EntryIndex = ASCs.Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		if (!ASCs[EntryIndex].IsValid() || !AttributeSets[EntryIndex].IsValid())
+		{
+			RemoveEntryAtSwap(EntryIndex);
+		}
+	}
+
+	if (ASCs.IsEmpty())
+	{
+		StepAccumulator = 0.f;
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const bool bStaminaTrajectory = RegenCVars::CVarStaminaTrajectory.GetValueOnGameThread();
+
+	const float TickRate = RegenCVars::CVarTickRate.GetValueOnGameThread();
+	float StepTime = DeltaTime;
+	if (TickRate > 0.f)
+	{
+		// Whole fixed steps only, the remainder carries over
+		const float FixedStep = 1.f / TickRate;
+		StepAccumulator += DeltaTime;
+		const int32 NumSteps = FMath::FloorToInt32(StepAccumulator / FixedStep);
+		StepTime = NumSteps * FixedStep;
+		StepAccumulator -= StepTime;
+	}
+
+	if (StepTime > 0.f)
+	{
+		Integrate(StepTime, Now);
+
+		const double NetWriteInterval = RegenCVars::CVarNetWriteInterval.GetValueOnGameThread();
+		for (int32 EntryIndex = 0; EntryIndex < ASCs.Num(); ++EntryIndex)
+		{
+			const bool bNetWriteDue = Now >= NextWriteTimes[EntryIndex];
+			bool bWroteForNet = false;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				const int32 Row = EntryIndex * NumChannels + Channel;
+				const float Value = Values[Row];
+				if (Value == LastWrittenValues[Row])
+				{
+					continue;
+				}
+
+				// Clients evaluate the trajectory, so a changing stamina value only needs writing on thresholds
+				const bool bNetWriteApplies = bNetWriteDue && !(bStaminaTrajectory && Channel == static_cast<int32>(EIsekaiRegenChannel::Stamina));
+				const bool bHitThreshold = Value <= 0.f || Value >= Maxes[Row];
+				if (bHitThreshold || bNetWriteApplies)
+				{
+					WriteBack(Row);
+					bWroteForNet |= bNetWriteApplies;
+				}
+			}
+
+			if (bWroteForNet)
+			{
+				NextWriteTimes[EntryIndex] = Now + NetWriteInterval;
+			}
+		}
+	}
+
+	if (!bStaminaTrajectory)
+	{
+		return;
+	}
+
+	// Publish rate changes right away, and correct long-running curves against drift from the fixed steps
+	const float TrajectoryTime = static_cast<float>(Now - StepAccumulator);
+	for (int32 EntryIndex = 0; EntryIndex < ASCs.Num(); ++EntryIndex)
+	{
+		bool bPublish = TrajectoryDirtyFlags[EntryIndex] != 0;
+		if (!bPublish && Now >= NextCorrectionTimes[EntryIndex])
+		{
+			const UIsekaiAttributeSet* AttributeSet = AttributeSets[EntryIndex].Get();
+			bPublish = AttributeSet && AttributeSet->GetStaminaTrajectory().IsChanging(TrajectoryTime);
+		}
+
+		if (bPublish)
+		{
+			PublishStaminaTrajectory(EntryIndex, Now);
+		}
+	}
+}
+
+void UIsekaiRegenSubsystem::Integrate(const float DeltaTime, const double Now)
+{
+	const int32 NumRows = Values.Num();
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const bool bRegenBlocked = BlockedFlags[Row] != 0 || Now < RegenResumeTimes[Row];
+		const float Rate = (bRegenBlocked ? 0.f : RegenRates[Row]) - DrainRates[Row];
+		Values[Row] = FMath::Clamp(Values[Row] + Rate * DeltaTime, 0.f, Maxes[Row]);
+	}
+}
+
+void UIsekaiRegenSubsystem::WriteBack(const int32 Row)
+{
+	const int32 EntryIndex = Row / NumChannels;
+	const EIsekaiRegenChannel Channel = static_cast<EIsekaiRegenChannel>(Row % NumChannels);
+
+	UIsekaiAbilitySystemComponent* ASC = ASCs[EntryIndex].Get();
+	UIsekaiAttributeSet* AttributeSet = AttributeSets[EntryIndex].Get();
+	if (!ASC || !AttributeSet)
+	{
+		return;
+	}
+
+	const float Value = Values[Row];
+	{
+		TGuardValue<bool> WriteGuard(bWritingBack, true);
+		ASC->SetNumericAttributeBase(GetValueAttribute(Channel), Value);
+	}
+	LastWrittenValues[Row] = Value;
+
+	if (Channel == EIsekaiRegenChannel::Stamina)
+	{
+		++StaminaWriteCounts[EntryIndex];
+	}
+
+	// Direct writes skip PostGameplayEffectExecute, so the exhaustion thresholds are checked here
+	if (Channel == EIsekaiRegenChannel::Stamina && (Value <= 0.f || Value >= Maxes[Row]))
+	{
+		AttributeSet->HandleIntegratedStaminaChange(ASC);
+	}
+}
+
+void UIsekaiRegenSubsystem::PublishStaminaTrajectory(const int32 EntryIndex, const double Now)
+{
+	UIsekaiAttributeSet* AttributeSet = AttributeSets[EntryIndex].Get();
+	if (!AttributeSet)
+	{
+		return;
+	}
+
+	const int32 Row = RowIndex(EntryIndex, EIsekaiRegenChannel::Stamina);
+
+	FIsekaiStaminaTrajectory Trajectory;
+	// Values lag the clock by the unintegrated remainder
+	Trajectory.ServerTime = FMath::Max(static_cast<float>(Now - StepAccumulator), UE_KINDA_SMALL_NUMBER);
+	Trajectory.RegenResumeTime = static_cast<float>(RegenResumeTimes[Row]);
+	Trajectory.Value = Values[Row];
+	Trajectory.Max = Maxes[Row];
+	Trajectory.RegenRate = BlockedFlags[Row] != 0 ? 0.f : RegenRates[Row];
+	Trajectory.DrainRate = DrainRates[Row];
+	AttributeSet->SetStaminaTrajectory(Trajectory);
+
+	TrajectoryDirtyFlags[EntryIndex] = 0;
+	NextCorrectionTimes[EntryIndex] = Now + RegenCVars::CVarStaminaCorrectionInterval.GetValueOnGameThread();
+	++TrajectoryPublishCounts[EntryIndex];
+}
+
+void UIsekaiRegenSubsystem::MarkTrajectoryDirty(const int32 Row)
+{
+	if (Row % NumChannels == static_cast<int32>(EIsekaiRegenChannel::Stamina))
+	{
+		TrajectoryDirtyFlags[Row / NumChannels] = 1;
+	}
+}
+
+void UIsekaiRegenSubsystem::RefreshRowInputs(const int32 Row)
+{
+	const int32 EntryIndex = Row / NumChannels;
+	const EIsekaiRegenChannel Channel = static_cast<EIsekaiRegenChannel>(Row % NumChannels);
+
+	const UIsekaiAbilitySystemComponent* ASC = ASCs[EntryIndex].Get();
+	const UIsekaiAttributeSet* AttributeSet = AttributeSets[EntryIndex].Get();
+	if (!ASC || !AttributeSet)
+	{
+		return;
+	}
+
+	if (Channel == EIsekaiRegenChannel::Health)
+	{
+		Maxes[Row] = AttributeSet->GetMaxHealth();
+		RegenRates[Row] = AttributeSet->GetHealthRegenRate();
+		RegenDelays[Row] = AttributeSet->GetHealthRegenDelay();
+	}
+	else
+	{
+		Maxes[Row] = AttributeSet->GetMaxStamina();
+		RegenRates[Row] = AttributeSet->GetStaminaRegenRate();
+		RegenDelays[Row] = AttributeSet->GetStaminaRegenDelay();
+	}
+
+	BlockedFlags[Row] = ASC->HasMatchingGameplayTag(GetBlockedTag(Channel)) ? 1 : 0;
+	Values[Row] = FMath::Min(Values[Row], Maxes[Row]);
+	MarkTrajectoryDirty(Row);
+}
+
+// --- Delegate handlers ---
+void UIsekaiRegenSubsystem::OnValueChanged(const FOnAttributeChangeData& Data, const TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, const EIsekaiRegenChannel Channel)
+{
+	if (bWritingBack)
+	{
+		return;
+	}
+
+	const int32 EntryIndex = FindEntry(WeakASC.Get());
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Carry the external change (cost, damage, respawn reset) over the unwritten integration instead of snapping to it
+	const int32 Row = RowIndex(EntryIndex, Channel);
+	const float Delta = Data.NewValue - Data.OldValue;
+	Values[Row] = FMath::Clamp(Values[Row] + Delta, 0.f, Maxes[Row]);
+	LastWrittenValues[Row] = Data.NewValue;
+
+	// Spending or taking damage restarts the regen delay
+	if (Delta < 0.f)
+	{
+		RegenResumeTimes[Row] = FMath::Max(RegenResumeTimes[Row], GetWorld()->GetTimeSeconds() + RegenDelays[Row]);
+	}
+	MarkTrajectoryDirty(Row);
+}
+
+void UIsekaiRegenSubsystem::OnInputChanged(const FOnAttributeChangeData& Data, const TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, const EIsekaiRegenChannel Channel)
+{
+	const int32 EntryIndex = FindEntry(WeakASC.Get());
+	if (EntryIndex != INDEX_NONE)
+	{
+		RefreshRowInputs(RowIndex(EntryIndex, Channel));
+	}
+}
+
+void UIsekaiRegenSubsystem::OnBlockedTagChanged(FGameplayTag Tag, const int32 NewCount, const TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, const EIsekaiRegenChannel Channel)
+{
+	const int32 EntryIndex = FindEntry(WeakASC.Get());
+	if (EntryIndex != INDEX_NONE)
+	{
+		const int32 Row = RowIndex(EntryIndex, Channel);
+		BlockedFlags[Row] = NewCount > 0 ? 1 : 0;
+		MarkTrajectoryDirty(Row);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void UIsekaiRegenSubsystem::ReportNetStats()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Elapsed = FMath::Max(Now - NetStatsStartTime, UE_SMALL_NUMBER);
+
+	// Payload only, property headers and bunch overhead come on top of both
+	constexpr int32 AttributePayloadBytes = sizeof(float) * 2;
+	constexpr int32 TrajectoryPayloadBytes = sizeof(float) * 6;
+
+	UE_LOG(LogIsekaiAbilitySystem, Log, TEXT("Regen net report over %.1fs, stamina trajectory %s:"),
+		Elapsed, RegenCVars::CVarStaminaTrajectory.GetValueOnGameThread() ? TEXT("on") : TEXT("off"));
+
+	for (int32 EntryIndex = 0; EntryIndex < ASCs.Num(); ++EntryIndex)
+	{
+		const UIsekaiAbilitySystemComponent* ASC = ASCs[EntryIndex].Get();
+		const AActor* Avatar = ASC ? ASC->GetAvatarActor() : nullptr;
+		const double WritesPerSecond = StaminaWriteCounts[EntryIndex] / Elapsed;
+		const double PublishesPerSecond = TrajectoryPublishCounts[EntryIndex] / Elapsed;
+
+		UE_LOG(LogIsekaiAbilitySystem, Log,
+			TEXT("  %s: stamina writes %.2f/s, trajectory publishes %.2f/s, ~%.0f B/s payload, draining %.1f/s"),
+			*GetNameSafe(Avatar), WritesPerSecond, PublishesPerSecond,
+			WritesPerSecond * AttributePayloadBytes + PublishesPerSecond * TrajectoryPayloadBytes,
+			DrainRates[RowIndex(EntryIndex, EIsekaiRegenChannel::Stamina)]);
+
+		StaminaWriteCounts[EntryIndex] = 0;
+		TrajectoryPublishCounts[EntryIndex] = 0;
+	}
+
+	NetStatsStartTime = Now;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GRegenNetReportCommand(
+	TEXT("Isekai.Regen.NetReport"),
+	TEXT("Logs stamina replication updates per second for every ASC tracked by the regen subsystem, then resets the counters. ")
+	TEXT("Sprint for a while between two reports, once with Isekai.Regen.StaminaTrajectory 1 and once with 0."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UIsekaiRegenSubsystem* RegenSubsystem = World ? World->GetSubsystem<UIsekaiRegenSubsystem>() : nullptr)
+		{
+			RegenSubsystem->ReportNetStats();
+		}
+	}));
+#endif
+
+TStatId UIsekaiRegenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UIsekaiRegenSubsystem, STATGROUP_Tickables);
+}
+
+bool UIsekaiRegenSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 V4LKdev and Vlad. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "IsekaiRegenSubsystem.generated.h"
+
+class UIsekaiAbilitySystemComponent;
+class UIsekaiAttributeSet;
+
+/** Attribute pairs integrated by the regen subsystem. */
+enum class EIsekaiRegenChannel : uint8
+{
+	Health,
+	Stamina,
+	MAX
+};
+
+/**
+ * Server-only integrator for health and stamina regeneration and continuous stamina drain.
+ * Every registered ASC owns one row per channel in a set of dense arrays (value, max, regen rate, drain rate, delay,
+ * blocked state), all rows are integrated in a single pass at a fixed rate, and values are only written back through
+ * the attribute set when they reach a threshold (empty or full) or the next net write is due.
+ * Inputs are kept current through attribute and tag change delegates, so the pass never touches the ASC.
+ * With Isekai.Regen.StaminaTrajectory, stamina is replicated as an FIsekaiStaminaTrajectory published on rate changes
+ * and a slow correction interval instead, and the attribute is only written on thresholds and flushes.
+ */
+UCLASS()
+class AIASSESSMENT_API UIsekaiRegenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * True when regen is integrated here rather than by periodic effects, see UIsekaiAbilitySystemSettings.
+	 * Clients use it to pick the same regen delay and drain mechanism as the server.
+	 */
+	static bool IsIntegrationEnabled();
+	
+	// --- Registration ---
+	void RegisterASC(UIsekaiAbilitySystemComponent* ASC, UIsekaiAttributeSet* AttributeSet);
+	void UnregisterASC(UIsekaiAbilitySystemComponent* ASC);
+	bool IsRegistered(const UIsekaiAbilitySystemComponent* ASC) const;
+
+	// --- Drain & Delay ---
+	/** Adds a continuous drain in units per second. Drains stack and ignore regen blocking. Returns false if the ASC is not registered. */
+	bool AddDrain(UIsekaiAbilitySystemComponent* ASC, EIsekaiRegenChannel Channel, float RatePerSecond);
+	void RemoveDrain(UIsekaiAbilitySystemComponent* ASC, EIsekaiRegenChannel Channel, float RatePerSecond);
+
+	/** Suspends regen for the channel's delay attribute. Returns false if the ASC is not registered. */
+	bool DelayRegen(UIsekaiAbilitySystemComponent* ASC, EIsekaiRegenChannel Channel);
+
+	/** Writes the integrated values back immediately, e.g. before a server-side cost is applied. */
+	void Flush(const UIsekaiAbilitySystemComponent* ASC);
+	
+	/** Reads the integrated value without writing it back. Returns false if the ASC is not registered. */
+	bool GetIntegratedValue(const UIsekaiAbilitySystemComponent* ASC, EIsekaiRegenChannel Channel, float& OutValue) const;
+
+	int32 GetNumRegistered() const { return ASCs.Num(); }
+
+#if !UE_BUILD_SHIPPING
+	/** Logs stamina replication updates per second for every tracked ASC since the last report. */
+	void ReportNetStats();
+#endif
+
+	// --- FTickableGameObject ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	static int32 RowIndex(const int32 EntryIndex, const EIsekaiRegenChannel Channel) { return EntryIndex * static_cast<int32>(EIsekaiRegenChannel::MAX) + static_cast<int32>(Channel); }
+
+	int32 FindEntry(const UIsekaiAbilitySystemComponent* ASC) const;
+	void RemoveEntryAtSwap(int32 EntryIndex);
+
+	/** Reads max, rate and delay attributes and the blocked tag count into the row. */
+	void RefreshRowInputs(int32 Row);
+
+	void Integrate(float DeltaTime, double Now);
+	void WriteBack(int32 Row);
+	void PublishStaminaTrajectory(int32 EntryIndex, double Now);
+	void MarkTrajectoryDirty(int32 Row);
+
+	// --- Delegate handlers ---
+	void OnValueChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, EIsekaiRegenChannel Channel);
+	void OnInputChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, EIsekaiRegenChannel Channel);
+	void OnBlockedTagChanged(FGameplayTag Tag, int32 NewCount, TWeakObjectPtr<UIsekaiAbilitySystemComponent> WeakASC, EIsekaiRegenChannel Channel);
+
+	// --- Entry Store (one per ASC) ---
+	TArray<TWeakObjectPtr<UIsekaiAbilitySystemComponent>> ASCs;
+	TArray<TWeakObjectPtr<UIsekaiAttributeSet>> AttributeSets;
+	TArray<double> NextWriteTimes;
+	TArray<double> NextCorrectionTimes;
+	TArray<uint8> TrajectoryDirtyFlags;
+	/** Stamina attribute writes and trajectory publishes since the last net report. */
+	TArray<int32> StaminaWriteCounts;
+	TArray<int32> TrajectoryPublishCounts;
+	double NetStatsStartTime = 0.0;
+	TMap<TWeakObjectPtr<UIsekaiAbilitySystemComponent>, int32> ASCToIndex;
+
+	// --- Row Store (SoA, one row per entry and channel, see RowIndex) ---
+	/** Authoritative integrated value. The attribute only catches up on write back. */
+	TArray<float> Values;
+	TArray<float> Maxes;
+	TArray<float> RegenRates;
+	TArray<float> DrainRates;
+	TArray<float> RegenDelays;
+	TArray<double> RegenResumeTimes;
+	TArray<float> LastWrittenValues;
+	TArray<uint8> BlockedFlags;
+
+	float StepAccumulator = 0.f;
+
+	/** Set while writing back, so our own attribute changes are not mistaken for external ones. */
+	bool bWritingBack = false;
+};